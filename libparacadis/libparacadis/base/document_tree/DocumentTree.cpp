@@ -22,6 +22,8 @@
 
 #include "DocumentTree.h"
 
+#include <cassert>
+
 namespace Document
 {
   std::string DocumentTree::toString() const
@@ -29,4 +31,12 @@ namespace Document
     return std::format(
         "Root container for the whole document ({}).", getName());
   }
+
+  void DocumentTree::setChordalTolerance(double tolerance)
+  {
+    assert(tolerance > 0 && "Tolerance must be positive.");
+    if(chordalTolerance.exchange(tolerance) != tolerance) {
+      tessellation_changed_sig.emit_signal();
+    }
+  }
 }
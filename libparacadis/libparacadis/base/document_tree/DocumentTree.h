@@ -24,11 +24,27 @@
 
 #include "Container.h"
 
+#include <atomic>
+
 namespace Document
 {
   class DocumentTree : public Container
   {
   public:
     std::string toString() const override;
+
+    /**
+     * Maximum distance between the geometries and their tessellations,
+     * in model units. Views may override it.
+     */
+    /// @{
+    double getChordalTolerance() const { return chordalTolerance; }
+    void setChordalTolerance(double tolerance);
+    /// @}
+
+    Threads::Signal<> tessellation_changed_sig;
+
+  private:
+    std::atomic<double> chordalTolerance = 1e-2;
   };
 }
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cmath>
+#include <variant>
+
+SCENARIO("Circle through three points", "[simple]")
+{
+  GIVEN("three points on a circle of radius 5, centered away from the origin")
+  {
+    // The barycentric weights of the circumcenter do not add up to one
+    // for these points: they must be normalized.
+    auto a = SharedPtr<DeferenceablePoint>::make_shared(6, -2, 5);
+    auto b = SharedPtr<DeferenceablePoint>::make_shared(4, 2, 5);
+    auto c = SharedPtr<DeferenceablePoint>::make_shared(-3, -5, 5);
+    auto circle = SharedPtr<Circle3Points>::make_shared(*a, *b, *c);
+
+    WHEN("we get its analytic shape")
+    {
+      const auto shape = circle->getAnalyticShape();
+
+      THEN("it is a circle with the right center and radius")
+      {
+        REQUIRE(shape.has_value());
+        REQUIRE(std::holds_alternative<AnalyticCircle>(*shape));
+        const auto& analytic = std::get<AnalyticCircle>(*shape);
+        REQUIRE(std::abs(analytic.center[0] - 1) < 1e-9);
+        REQUIRE(std::abs(analytic.center[1] + 2) < 1e-9);
+        REQUIRE(std::abs(analytic.center[2] - 5) < 1e-9);
+        REQUIRE(std::abs(analytic.radius - 5) < 1e-9);
+      }
+
+      THEN("it is oriented by a --> b --> c")
+      {
+        const auto& analytic = std::get<AnalyticCircle>(*shape);
+        REQUIRE(std::abs(analytic.normal[0]) < 1e-9);
+        REQUIRE(std::abs(analytic.normal[1]) < 1e-9);
+        REQUIRE(std::abs(analytic.normal[2] - 1) < 1e-9);
+      }
+
+      THEN("it starts at the first point")
+      {
+        const auto& analytic = std::get<AnalyticCircle>(*shape);
+        REQUIRE(std::abs(analytic.xdir[0] - 1) < 1e-9);
+        REQUIRE(std::abs(analytic.xdir[1]) < 1e-9);
+        REQUIRE(std::abs(analytic.xdir[2]) < 1e-9);
+      }
+    }
+  }
+}
@@ -23,3 +23,4 @@
 #include "010_container_basic_operations/container_basics.hpp"
 #include "020_move_and_copy/move_and_copy.hpp"
 #include "040_element_access_using_paths/element_access.hpp"
+#include "050_geometric_primitives/geometric_primitives.hpp"
@@ -28,10 +28,45 @@
 
 #include <gismo/gismo.h>
 
+#include <array>
 #include <concepts>
+#include <optional>
+#include <variant>
 
 namespace Document
 {
+  /**
+   * Exact descriptions of the analytic primitives.
+   *
+   * Consumers that know them (like the mesher) use them directly,
+   * instead of evaluating the NURBS, which stays the reference
+   * for everyone else.
+   */
+  /// @{
+  struct AnalyticSphere
+  {
+    std::array<real_t, 3> center;
+    real_t                radius;
+  };
+
+  /**
+   * Parametrized by \f$c + r(\cos t\,x + \sin t\,y)\f$,
+   * with \f$y = n \times x\f$.
+   */
+  struct AnalyticCircle
+  {
+    std::array<real_t, 3> center;
+    /// Unit normal.
+    std::array<real_t, 3> normal;
+    /// Unit vector, orthogonal to `normal`: where the circle starts.
+    std::array<real_t, 3> xdir;
+    real_t                radius;
+  };
+
+  using AnalyticShape = std::variant<AnalyticSphere, AnalyticCircle>;
+  /// @}
+
+
   class DocumentGeometry
     : public virtual Naming::ExporterCommon
   {
@@ -41,6 +76,11 @@ namespace Document
     using iga_surface_t  = gismo::gsSurface<real_t>;
 
     virtual SharedPtr<const iga_geometry_t> getIgaGeometry() const = 0;
+    /**
+     * The exact shape of analytic primitives, if this is one.
+     * It is the same as getIgaGeometry(), up to parametrization.
+     */
+    virtual std::optional<AnalyticShape> getAnalyticShape() const { return {}; }
     virtual ~DocumentGeometry() = default;
   };
 
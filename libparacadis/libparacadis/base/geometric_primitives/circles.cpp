@@ -30,21 +30,58 @@ using namespace Document;
 using namespace types;
 
 namespace {
-  SharedPtr<gismo::gsNurbs<real_t>>
-  nurbs_circle(const Point& center, Vector normal,
-               const Vector& xdir_radius)
+  std::array<real_t, 3> to_array(const Vector& v)
+  {
+    return {to_float(v.x()), to_float(v.y()), to_float(v.z())};
+  }
+
+  /**
+   * The circle of @a center and @a normal that passes through
+   * `center + xdir_radius`.
+   */
+  AnalyticCircle analytic_circle(const Point& center, Vector normal,
+                                 Vector xdir_radius)
   {
     normal /= sqrt(normal.squared_length());
+    const auto radius = sqrt(xdir_radius.squared_length());
+    xdir_radius /= radius;
+    return {to_array(center.to_vector()), to_array(normal),
+            to_array(xdir_radius), to_float(radius)};
+  }
 
-    const Vector& xdir = xdir_radius;
-    double xdirx = to_float(xdir.x());
-    double xdiry = to_float(xdir.y());
-    double xdirz = to_float(xdir.z());
+  AnalyticCircle circle_3_points(const Point& A, const Point& B,
+                                 const Point& C)
+  {
+    auto u = C - B;
+    auto v = A - C;
+    auto w = B - A;
 
-    Vector ydir = cross_product(normal, xdir);
-    double ydirx = to_float(ydir.x());
-    double ydiry = to_float(ydir.y());
-    double ydirz = to_float(ydir.z());
+    // Barycentric coordinates of the circumcenter, up to a factor.
+    auto a = u.squared_length() * dot_product(v, w);
+    auto b = v.squared_length() * dot_product(w, u);
+    auto c = w.squared_length() * dot_product(u, v);
+
+    auto center = ((a*A.to_vector() + b*B.to_vector() + c*C.to_vector()) / (a + b + c)).to_point();
+    auto normal = cross_product(u, v);
+
+    return analytic_circle(center, std::move(normal), A - center);
+  }
+
+  SharedPtr<gismo::gsNurbs<real_t>>
+  nurbs_circle(const AnalyticCircle& circle)
+  {
+    const auto& [normalx, normaly, normalz] = circle.normal;
+    const auto& [xx, xy, xz] = circle.xdir;
+    const double radius = circle.radius;
+
+    double xdirx = radius * xx;
+    double xdiry = radius * xy;
+    double xdirz = radius * xz;
+
+    // normal x xdir
+    double ydirx = radius * (normaly * xz - normalz * xy);
+    double ydiry = radius * (normalz * xx - normalx * xz);
+    double ydirz = radius * (normalx * xy - normaly * xx);
 
     gismo::gsKnotVector<real_t> KV2 (0,1,3,3,2) ;
     gismo::gsMatrix<real_t> C(9,3) ;
@@ -59,9 +96,9 @@ namespace {
       xdirx-ydirx, xdiry-ydiry, xdirz-ydirz,
       xdirx,       xdiry,       xdirz;
 
-    C.col(0).array() += to_float(center.x());
-    C.col(1).array() += to_float(center.y());
-    C.col(2).array() += to_float(center.z());
+    C.col(0).array() += circle.center[0];
+    C.col(1).array() += circle.center[1];
+    C.col(2).array() += circle.center[2];
 
     gismo::gsMatrix<real_t> ww(9,1) ;
     ww <<
@@ -72,24 +109,6 @@ namespace {
 
     return std::make_shared<gismo::gsNurbs<real_t>>(KV2, give(ww), give(C));
   }
-
-  SharedPtr<gismo::gsNurbs<real_t>>
-  nurbs_circle_3_points(const Point& A, const Point& B,
-                        const Point& C)
-  {
-    auto u = C - B;
-    auto v = A - C;
-    auto w = B - A;
-
-    auto a = u.squared_length() * dot_product(v, w);
-    auto b = v.squared_length() * dot_product(w, u);
-    auto c = w.squared_length() * dot_product(u, v);
-
-    auto center = (a*A.to_vector() + b*B.to_vector() + c*C.to_vector()).to_point();
-    auto normal = cross_product(u, v);
-
-    return nurbs_circle(center, std::move(normal), A - center);
-  }
 }
 
 CirclePointRadius2Normal::CirclePointRadius2Normal(Point center, Real radius2, Vector normal)
@@ -103,8 +122,7 @@ SharedPtr<CirclePointRadius2Normal> CirclePointRadius2Normal::deepCopy() const
   return SharedPtrWrap<CirclePointRadius2Normal>(gate->center, gate->radius2, gate->normal);
 }
 
-SharedPtr<const DocumentGeometry::iga_curve_t>
-CirclePointRadius2Normal::produceIgaCurve() const
+std::optional<AnalyticShape> CirclePointRadius2Normal::getAnalyticShape() const
 {
   Point center;
   real_t radius;
@@ -137,7 +155,13 @@ CirclePointRadius2Normal::produceIgaCurve() const
 
   xdir *= (radius / to_float(sqrt(xdir.squared_length())));
 
-  return nurbs_circle(center, std::move(normal), xdir);
+  return analytic_circle(center, std::move(normal), std::move(xdir));
+}
+
+SharedPtr<const DocumentGeometry::iga_curve_t>
+CirclePointRadius2Normal::produceIgaCurve() const
+{
+  return nurbs_circle(std::get<AnalyticCircle>(*getAnalyticShape()));
 }
 
 
@@ -152,8 +176,7 @@ SharedPtr<Circle3Points> Circle3Points::deepCopy() const
   return SharedPtrWrap<Circle3Points>(gate->a, gate->b, gate->c);
 }
 
-SharedPtr<const DocumentGeometry::iga_curve_t>
-Circle3Points::produceIgaCurve() const
+std::optional<AnalyticShape> Circle3Points::getAnalyticShape() const
 {
   Point a, b, c;
   {
@@ -162,7 +185,13 @@ Circle3Points::produceIgaCurve() const
     b = gate->b;
     c = gate->c;
   }
-  return nurbs_circle_3_points(a, b, c);
+  return circle_3_points(a, b, c);
+}
+
+SharedPtr<const DocumentGeometry::iga_curve_t>
+Circle3Points::produceIgaCurve() const
+{
+  return nurbs_circle(std::get<AnalyticCircle>(*getAnalyticShape()));
 }
 
 
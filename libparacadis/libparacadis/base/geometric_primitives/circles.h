@@ -63,6 +63,8 @@ public:
   SharedPtr<Naming::ExporterCommon> deepCopyExporter() const override
   { return deepCopy(); }
 
+  std::optional<Document::AnalyticShape> getAnalyticShape() const override;
+
 private:
   SharedPtr<const iga_curve_t> produceIgaCurve() const override;
 };
@@ -100,6 +102,8 @@ public:
   SharedPtr<Naming::ExporterCommon> deepCopyExporter() const override
   { return deepCopy(); }
 
+  std::optional<Document::AnalyticShape> getAnalyticShape() const override;
+
 private:
   SharedPtr<const iga_curve_t> produceIgaCurve() const override;
 };
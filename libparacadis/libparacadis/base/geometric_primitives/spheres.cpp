@@ -26,6 +26,23 @@
 
 using namespace Document;
 
+namespace {
+  AnalyticSphere analytic_sphere(const Point& center, real_t radius2)
+  {
+    return {{types::to_float(center.x()),
+             types::to_float(center.y()),
+             types::to_float(center.z())},
+            std::sqrt(radius2)};
+  }
+
+  SharedPtr<const DocumentGeometry::iga_surface_t>
+  nurbs_sphere(const AnalyticSphere& sphere)
+  {
+    const auto& [x, y, z] = sphere.center;
+    return SharedPtr{gismo::gsNurbsCreator<real_t>::NurbsSphere(sphere.radius, x, y, z)};
+  }
+}
+
 /*
  * SphereCenterRadius2
  */
@@ -40,8 +57,7 @@ SharedPtr<SphereCenterRadius2> SphereCenterRadius2::deepCopy() const
   return SharedPtrWrap<SphereCenterRadius2>(gate->center, gate->radius2);
 }
 
-SharedPtr<const DocumentGeometry::iga_surface_t>
-SphereCenterRadius2::produceIgaSurface() const
+std::optional<AnalyticShape> SphereCenterRadius2::getAnalyticShape() const
 {
   Point  center;
   real_t radius2;
@@ -50,10 +66,13 @@ SphereCenterRadius2::produceIgaSurface() const
     radius2 = types::to_float(gate->radius2);
     center = gate->center;
   }
-  real_t x = types::to_float(center.x());
-  real_t y = types::to_float(center.y());
-  real_t z = types::to_float(center.z());
-  return SharedPtr{gismo::gsNurbsCreator<real_t>::NurbsSphere(std::sqrt(radius2), x, y, z)};
+  return analytic_sphere(center, radius2);
+}
+
+SharedPtr<const DocumentGeometry::iga_surface_t>
+SphereCenterRadius2::produceIgaSurface() const
+{
+  return nurbs_sphere(std::get<AnalyticSphere>(*getAnalyticShape()));
 }
 
 
@@ -69,8 +88,7 @@ SharedPtr<SphereCenterSurfacePoint> SphereCenterSurfacePoint::deepCopy() const
   return SharedPtrWrap<SphereCenterSurfacePoint>(gate->center, gate->surface_point);
 }
 
-SharedPtr<const DocumentGeometry::iga_surface_t>
-SphereCenterSurfacePoint::produceIgaSurface() const
+std::optional<AnalyticShape> SphereCenterSurfacePoint::getAnalyticShape() const
 {
   Point center;
   Point surface_point;
@@ -79,11 +97,13 @@ SphereCenterSurfacePoint::produceIgaSurface() const
     surface_point = gate->surface_point;
     center = gate->center;
   }
-  real_t radius2 = types::to_float((surface_point-center).squared_length());
-  real_t x = types::to_float(center.x());
-  real_t y = types::to_float(center.y());
-  real_t z = types::to_float(center.z());
-  return SharedPtr{gismo::gsNurbsCreator<real_t>::NurbsSphere(std::sqrt(radius2), x, y, z)};
+  return analytic_sphere(center, types::to_float((surface_point-center).squared_length()));
+}
+
+SharedPtr<const DocumentGeometry::iga_surface_t>
+SphereCenterSurfacePoint::produceIgaSurface() const
+{
+  return nurbs_sphere(std::get<AnalyticSphere>(*getAnalyticShape()));
 }
 
 
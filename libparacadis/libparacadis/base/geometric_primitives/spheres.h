@@ -62,6 +62,8 @@ public:
   SharedPtr<Naming::ExporterCommon> deepCopyExporter() const override
   { return deepCopy(); }
 
+  std::optional<Document::AnalyticShape> getAnalyticShape() const override;
+
 private:
   SharedPtr<const iga_surface_t> produceIgaSurface() const override;
 };
@@ -96,6 +98,8 @@ public:
   SharedPtr<Naming::ExporterCommon> deepCopyExporter() const override
   { return deepCopy(); }
 
+  std::optional<Document::AnalyticShape> getAnalyticShape() const override;
+
 private:
   SharedPtr<const iga_surface_t> produceIgaSurface() const override;
 };
@@ -22,6 +22,8 @@
 
 #include "DedicatedThreadScope.h"
 
+#include <algorithm>
+#include <cassert>
 #include <exception>
 #include <iostream>
 
@@ -29,26 +31,217 @@ namespace Threads
 {
   void DedicatedThreadScopeBase::execute() noexcept
   {
-    auto it = callables.begin();
-    while(it != callables.end()) {
+    executing = true;
+    // Callables appended during execution go to `pending`,
+    // so `callables` is not resized while we iterate.
+    const auto count = callables.size();
+    for(size_t i = 0; i < count; ++i) {
+      auto& record = callables[i];
+      if(record.discarded) {
+        continue;
+      }
+
       bool keep = true;
+      const auto start = timing ? clock_t::now() : clock_t::time_point{};
       try {
-        keep = (*it)();
+        keep = record.callable();
       } catch(const std::exception& e) {
         std::cerr << "Exception caught in rednering queue: " << e.what() << ".\n";
       } catch(...) {
         std::cerr << "Unkown exception caught in rendering queue.\n";
       }
-      if(!keep) {
-        it = callables.erase(it);
-      } else {
-        ++it;
+
+      if(timing) {
+        auto& t = record.timing;
+        t.last = clock_t::now() - start;
+        t.max = std::max(t.max, t.last);
+        t.total += t.last;
+        ++t.calls;
+      }
+
+      if(!keep && !record.discarded) {
+        record.discarded = true;
+        discarded.push_back(i);
+      }
+    }
+    executing = false;
+    compact();
+  }
+
+
+  size_t DedicatedThreadScopeBase::callableCount() const
+  {
+    auto pending_count = std::ranges::count(pending, false, &record_t::discarded);
+    return callables.size() - discarded.size() + pending_count;
+  }
+
+
+  CallableHandle
+  DedicatedThreadScopeBase::appendCallable(inner_callable_t callable, std::string name)
+  {
+    const auto handle = reserveHandle();
+    registerCallable(handle, std::move(callable), std::move(name));
+    return handle;
+  }
+
+
+  CallableHandle DedicatedThreadScopeBase::reserveHandle()
+  {
+    std::scoped_lock lock{slotsMutex};
+    std::uint32_t slot;
+    if(freeSlots.empty()) {
+      slot = static_cast<std::uint32_t>(slots.size());
+      slots.emplace_back();
+    } else {
+      slot = freeSlots.back();
+      freeSlots.pop_back();
+    }
+    slots[slot].index = queued_index;
+    return {slot, slots[slot].generation};
+  }
+
+
+  void DedicatedThreadScopeBase::registerCallable(CallableHandle handle,
+                                                  inner_callable_t callable,
+                                                  std::string name)
+  {
+    std::scoped_lock lock{slotsMutex};
+    auto& slot = slots[handle.slot];
+    assert(slot.generation == handle.generation && "Reserved slot was released.");
+    if(slot.index == cancelled_index) {
+      releaseSlot(handle.slot);
+      return;
+    }
+    assert(slot.index == queued_index && "Slot registered twice.");
+
+    record_t record{std::move(callable), handle.slot, false,
+                    CallableTiming{.handle = handle, .name = std::move(name)}};
+    if(executing) {
+      slot.index = pending_index;
+      pending.emplace_back(std::move(record));
+    } else {
+      slot.index = static_cast<std::uint32_t>(callables.size());
+      callables.emplace_back(std::move(record));
+    }
+  }
+
+
+  bool DedicatedThreadScopeBase::removeCallable(CallableHandle handle)
+  {
+    std::scoped_lock lock{slotsMutex};
+    if(!handle.isValid() || handle.slot >= slots.size()) {
+      return false;
+    }
+    auto& slot = slots[handle.slot];
+    if(slot.generation != handle.generation) {
+      return false;
+    }
+
+    if(slot.index == cancelled_index) {
+      return false;
+    }
+    if(slot.index == queued_index) {
+      // Released when the dedicated thread pulls it from the queue.
+      slot.index = cancelled_index;
+      return true;
+    }
+
+    if(slot.index == pending_index) {
+      auto it = std::ranges::find(pending, handle.slot, &record_t::slot);
+      assert(it != pending.end() && "Pending callable not found.");
+      if(it->discarded) {
+        return false;
+      }
+      it->discarded = true;
+      return true;
+    }
+
+    auto& record = callables[slot.index];
+    if(record.discarded) {
+      return false;
+    }
+    record.discarded = true;
+    if(executing) {
+      discarded.push_back(slot.index);
+    } else {
+      swapRemove(slot.index);
+    }
+    return true;
+  }
+
+
+  void DedicatedThreadScopeBase::setTiming(bool enabled)
+  {
+    if(enabled && !timing) {
+      // Start a fresh measurement.
+      for(auto& record: callables) {
+        record.timing = CallableTiming{.handle = record.timing.handle,
+                                       .name = std::move(record.timing.name)};
+      }
+    }
+    timing = enabled;
+  }
+
+
+  std::vector<DedicatedThreadScopeBase::CallableTiming>
+  DedicatedThreadScopeBase::getTimings() const
+  {
+    std::vector<CallableTiming> result;
+    result.reserve(callables.size());
+    for(auto& record: callables) {
+      if(!record.discarded) {
+        result.push_back(record.timing);
       }
     }
+    return result;
   }
 
-  void DedicatedThreadScopeBase::appendCallable(inner_callable_t callable)
+
+  void DedicatedThreadScopeBase::compact()
+  {
+    assert(!executing);
+    if(discarded.empty() && pending.empty()) {
+      return;
+    }
+
+    std::scoped_lock lock{slotsMutex};
+
+    // Removing from the back to the front guarantees that the
+    // element moved into a removed position was not discarded.
+    std::ranges::sort(discarded, std::greater{});
+    for(auto index: discarded) {
+      swapRemove(index);
+    }
+    discarded.clear();
+
+    for(auto& record: pending) {
+      if(record.discarded) {
+        releaseSlot(record.slot);
+        continue;
+      }
+      slots[record.slot].index = static_cast<std::uint32_t>(callables.size());
+      callables.emplace_back(std::move(record));
+    }
+    pending.clear();
+  }
+
+
+  void DedicatedThreadScopeBase::swapRemove(std::uint32_t index)
+  {
+    assert(index < callables.size());
+    releaseSlot(callables[index].slot);
+
+    if(index + 1 != callables.size()) {
+      callables[index] = std::move(callables.back());
+      slots[callables[index].slot].index = index;
+    }
+    callables.pop_back();
+  }
+
+
+  void DedicatedThreadScopeBase::releaseSlot(std::uint32_t slot)
   {
-    callables.emplace_back(std::move(callable));
+    ++slots[slot].generation;
+    freeSlots.push_back(slot);
   }
 }  // namespace Threads
@@ -24,26 +24,162 @@
 
 #include "../safe_structs/ThreadSafeQueue.h"
 
+#include <chrono>
+#include <cstdint>
 #include <functional>
-#include <list>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <vector>
 
 namespace Threads
 {
+  /**
+   * Identifies a callable registered in a DedicatedThreadScopeBase.
+   *
+   * Callables are kept in a contiguous array and are moved around
+   * whenever others are removed. The handle, though, does not change.
+   * When the callable is discarded, the handle becomes stale.
+   */
+  struct CallableHandle
+  {
+    static constexpr std::uint32_t invalid_slot = std::numeric_limits<std::uint32_t>::max();
+
+    std::uint32_t slot       = invalid_slot;
+    std::uint32_t generation = 0;
+
+    bool isValid() const { return slot != invalid_slot; }
+    bool operator==(const CallableHandle&) const = default;
+  };
+
   class DedicatedThreadScopeBase
   {
   public:
+    using clock_t    = std::chrono::steady_clock;
+    using duration_t = clock_t::duration;
+
+    /**
+     * Time spent by one callable.
+     * Only collected when timing is enabled: setTiming().
+     */
+    struct CallableTiming
+    {
+      CallableHandle handle;
+      std::string    name;
+      duration_t     last{};
+      duration_t     max{};
+      duration_t     total{};
+      std::uint64_t  calls = 0;
+    };
+
     virtual ~DedicatedThreadScopeBase() = default;
     virtual void execute() noexcept;
 
+    /**
+     * Number of registered callables.
+     *
+     * @attention
+     * Only to be called by the dedicated thread.
+     */
+    size_t callableCount() const;
+
+    /**
+     * Discards a registered callable, as if it had returned `false`.
+     * A callable that is still queued (see DedicatedThreadScopeT::newAction())
+     * is discarded without ever being executed.
+     *
+     * @returns `false` if the handle is stale.
+     *
+     * @attention
+     * Only to be called by the dedicated thread.
+     */
+    bool removeCallable(CallableHandle handle);
+
+    /**
+     * Measures how long each callable takes to execute.
+     * This is meant to find which GUI element is eating the frame budget.
+     *
+     * @attention
+     * Only to be called by the dedicated thread.
+     */
+    /// @{
+    void setTiming(bool enabled);
+    bool isTiming() const { return timing; }
+    std::vector<CallableTiming> getTimings() const;
+    /// @}
+
   protected:
     using inner_callable_t = std::function<bool()>;
-    using callable_list_t = std::list<inner_callable_t>;
-    using callable_iter_t = callable_list_t::const_iterator;
 
-    void appendCallable(inner_callable_t callable);
+    CallableHandle appendCallable(inner_callable_t callable, std::string name = {});
+
+    /**
+     * Allocates a slot for a callable that will be registered later,
+     * with registerCallable(). Thread safe.
+     */
+    CallableHandle reserveHandle();
+
+    /**
+     * Registers the callable of a handle from reserveHandle().
+     * If the handle was removed in the meantime, the callable is dropped.
+     */
+    void registerCallable(CallableHandle handle, inner_callable_t callable,
+                          std::string name);
 
   private:
-    callable_list_t callables;
+    struct record_t
+    {
+      inner_callable_t callable;
+      std::uint32_t    slot;
+      bool             discarded = false;
+      CallableTiming   timing;
+    };
+
+    /**
+     * Maps a CallableHandle::slot to the index in `callables`.
+     */
+    struct slot_t
+    {
+      std::uint32_t index;
+      std::uint32_t generation = 0;
+    };
+
+    static constexpr std::uint32_t pending_index = std::numeric_limits<std::uint32_t>::max();
+    /// Reserved by reserveHandle(), not registered yet.
+    static constexpr std::uint32_t queued_index = pending_index - 1;
+    /// Reserved, and removed before being registered.
+    static constexpr std::uint32_t cancelled_index = pending_index - 2;
+
+    std::vector<record_t>      callables;
+
+    /**
+     * Handles are reserved by any thread (reserveHandle()).
+     */
+    /// @{
+    std::mutex                 slotsMutex;
+    /// Protected by `slotsMutex`.
+    std::vector<slot_t>        slots;
+    /// Protected by `slotsMutex`.
+    std::vector<std::uint32_t> freeSlots;
+    /// @}
+
+    /**
+     * While executing, the callables vector cannot reallocate
+     * and cannot have its elements moved. So, we postpone.
+     */
+    /// @{
+    bool                       executing = false;
+    std::vector<record_t>      pending;
+    std::vector<std::uint32_t> discarded;
+    /// @}
+
+    bool timing = false;
+
+    void            compact();
+    /// @attention Call it holding `slotsMutex`.
+    void            swapRemove(std::uint32_t index);
+    /// @attention Call it holding `slotsMutex`.
+    void            releaseSlot(std::uint32_t slot);
   };
 
   template<typename ProtectedStruct>
@@ -55,11 +191,27 @@ namespace Threads
     using callable_t = std::function<bool(struct_t&)>;
 
     void execute() noexcept override;
-    void newAction(callable_t callable);
 
-  private:
+    /**
+     * Queues an action to be executed by the dedicated thread.
+     *
+     * @param name - Used to identify the action in getTimings().
+     * @returns a handle for removeCallable(). It is valid right away,
+     * even before the dedicated thread registers the action.
+     */
+    CallableHandle newAction(callable_t callable, std::string name = {});
+
+  protected:
     struct_t theStruct;
-    SafeStructs::ThreadSafeQueue<callable_t> queue;
+
+  private:
+    struct action_t
+    {
+      callable_t     callable;
+      std::string    name;
+      CallableHandle handle;
+    };
+    SafeStructs::ThreadSafeQueue<action_t> queue;
   };
 }  // namespace Threads
 
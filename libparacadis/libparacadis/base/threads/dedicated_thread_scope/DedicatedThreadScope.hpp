@@ -29,22 +29,24 @@ namespace Threads
   template<typename ProtectedStruct>
   void DedicatedThreadScopeT<ProtectedStruct>::execute() noexcept
   {
-    DedicatedThreadScopeBase::execute();
+    // New actions are registered before executing,
+    // so they are executed (and timed) together with the others.
     while(auto res = queue.try_pull())
     {
-      bool keep = (*res)(theStruct);
-      if(keep) {
-        auto closure = [&theStruct = theStruct, f=std::move(*res)]{
-          return f(theStruct);
-        };
-        appendCallable(closure);
-      }
+      auto closure = [&theStruct = theStruct, f=std::move(res->callable)]{
+        return f(theStruct);
+      };
+      registerCallable(res->handle, std::move(closure), std::move(res->name));
     }
+    DedicatedThreadScopeBase::execute();
   }
 
   template<typename ProtectedStruct>
-  void DedicatedThreadScopeT<ProtectedStruct>::newAction(callable_t callable)
+  CallableHandle
+  DedicatedThreadScopeT<ProtectedStruct>::newAction(callable_t callable, std::string name)
   {
-    queue.push(std::move(callable));
+    const auto handle = reserveHandle();
+    queue.push(action_t{std::move(callable), std::move(name), handle});
+    return handle;
   }
 }
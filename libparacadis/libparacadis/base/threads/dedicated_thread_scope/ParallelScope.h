@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "DedicatedThreadScope.h"
+
+#include <libparacadis/base/threads/thread_pool/ThreadPool.h>
+
+#include <concepts>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+namespace Threads
+{
+  /**
+   * A DedicatedThreadScopeT whose actions can be split in two parts:
+   * 1. A pure computation, executed in a ThreadPool.
+   * 2. A (short) part that uses the protected struct,
+   *    executed in the dedicated thread.
+   *
+   * Only the result of the computation is handed to the dedicated thread.
+   * Just like any other action, the second part must not block.
+   *
+   * @example
+   * scope.newParallelAction(
+   *   [data]{ return prepare_plot(data); },          // Thread pool.
+   *   [](ImGuiStruct& s, Plot plot){                  // Dedicated thread.
+   *     s.plot = std::move(plot);
+   *     return true;  // Compute again.
+   *   });
+   */
+  template<typename ProtectedStruct>
+  class ParallelScopeT
+    : public DedicatedThreadScopeT<ProtectedStruct>
+  {
+  public:
+    using struct_t = ProtectedStruct;
+
+    explicit ParallelScopeT(ThreadPool& pool = ThreadPool::global()) : pool(pool) {}
+
+    void execute() noexcept override;
+
+    using error_handler_t = bool(*)(struct_t&, std::exception_ptr);
+
+    /**
+     * Executes @a compute in the thread pool and then, in the dedicated thread,
+     * calls @a apply with the protected struct and the computed result.
+     *
+     * If @a apply returns `true`, the whole thing is done again:
+     * @a compute is dispatched to the pool and the new result applied.
+     * At most once per execute().
+     *
+     * If @a compute throws, @a on_error is called instead of @a apply,
+     * in the dedicated thread, with the exception.
+     * If it returns `true`, @a compute is dispatched again.
+     * By default, the exception is logged and the action ends.
+     */
+    template<std::invocable Compute, typename Apply,
+             typename OnError = error_handler_t>
+      requires std::is_invocable_r_v<bool, Apply, struct_t&,
+                                     std::invoke_result_t<Compute>&&>
+            && std::is_invocable_r_v<bool, OnError, struct_t&, std::exception_ptr>
+    void newParallelAction(Compute compute, Apply apply,
+                           OnError on_error = &log_error);
+
+  private:
+    using result_t  = std::move_only_function<bool(struct_t&)>;
+    using results_t = SafeStructs::ThreadSafeQueue<result_t>;
+
+    ThreadPool& pool;
+
+    /**
+     * Computations that finish after the scope is destroyed
+     * simply fail to lock it and are discarded.
+     */
+    std::shared_ptr<results_t> results = std::make_shared<results_t>();
+
+    /**
+     * Results pulled at the beginning of execute(), before any is applied.
+     * Computations dispatched again by those results
+     * are only applied in the next execute().
+     */
+    std::vector<result_t> batch;
+
+    template<typename Compute, typename Apply, typename OnError>
+    struct parallel_action_t
+    {
+      Compute compute;
+      Apply   apply;
+      OnError onError;
+    };
+
+    template<typename Action>
+    void dispatch(std::shared_ptr<Action> action);
+
+    static bool log_error(struct_t&, std::exception_ptr error);
+  };
+}  // namespace Threads
+
+#include "ParallelScope.hpp"
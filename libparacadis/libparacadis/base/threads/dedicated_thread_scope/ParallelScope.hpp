@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "ParallelScope.h"
+
+#include <exception>
+#include <iostream>
+#include <optional>
+
+namespace Threads
+{
+  template<typename ProtectedStruct>
+  void ParallelScopeT<ProtectedStruct>::execute() noexcept
+  {
+    DedicatedThreadScopeT<ProtectedStruct>::execute();
+
+    // Applying a result may dispatch its computation again.
+    // If it finishes quickly, it must not be applied in this same call.
+    while(auto result = results->try_pull())
+    {
+      batch.push_back(std::move(*result));
+    }
+    for(auto& result: batch)
+    {
+      try {
+        result(this->theStruct);
+      } catch(const std::exception& e) {
+        std::cerr << "Exception caught in parallel scope: " << e.what() << ".\n";
+      } catch(...) {
+        std::cerr << "Unknown exception caught in parallel scope.\n";
+      }
+    }
+    batch.clear();
+  }
+
+  template<typename ProtectedStruct>
+  template<std::invocable Compute, typename Apply, typename OnError>
+    requires std::is_invocable_r_v<bool, Apply, ProtectedStruct&,
+                                   std::invoke_result_t<Compute>&&>
+          && std::is_invocable_r_v<bool, OnError, ProtectedStruct&, std::exception_ptr>
+  void ParallelScopeT<ProtectedStruct>::newParallelAction(Compute compute, Apply apply,
+                                                          OnError on_error)
+  {
+    using action_t = parallel_action_t<Compute, Apply, OnError>;
+    dispatch(std::make_shared<action_t>(std::move(compute), std::move(apply),
+                                        std::move(on_error)));
+  }
+
+  template<typename ProtectedStruct>
+  template<typename Action>
+  void ParallelScopeT<ProtectedStruct>::dispatch(std::shared_ptr<Action> action)
+  {
+    auto task = [this, weak_results = std::weak_ptr<results_t>(results), action] {
+      using value_t = std::invoke_result_t<decltype(action->compute)&>;
+      std::optional<value_t> value;
+      std::exception_ptr     error;
+      try {
+        value.emplace(action->compute());
+      } catch(...) {
+        error = std::current_exception();
+      }
+
+      auto _results = weak_results.lock();
+      if(!_results) {
+        return;
+      }
+
+      // Executed by the dedicated thread, in execute().
+      // So, the scope (this) is still alive.
+      if(error) {
+        _results->push(result_t{[this, error, action](struct_t& s) {
+          bool retry = action->onError(s, error);
+          if(retry) {
+            dispatch(action);
+          }
+          return retry;
+        }});
+        return;
+      }
+      _results->push(result_t{[this, value = std::move(*value), action](struct_t& s) mutable {
+        bool keep = action->apply(s, std::move(value));
+        if(keep) {
+          dispatch(action);
+        }
+        return keep;
+      }});
+    };
+    pool.submit(std::move(task));
+  }
+
+  template<typename ProtectedStruct>
+  bool ParallelScopeT<ProtectedStruct>::log_error(struct_t&, std::exception_ptr error)
+  {
+    try {
+      std::rethrow_exception(error);
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in parallel computation: " << e.what() << ".\n";
+    } catch(...) {
+      std::cerr << "Unknown exception caught in parallel computation.\n";
+    }
+    return false;
+  }
+}  // namespace Threads
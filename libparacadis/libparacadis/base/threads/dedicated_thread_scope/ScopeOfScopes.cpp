@@ -22,55 +22,165 @@
 
 #include "ScopeOfScopes.h"
 
+#include <algorithm>
+
 namespace Threads
 {
-  void ScopeOfScopesData::addScope(WeakPtr<DedicatedThreadScopeBase> scope)
+  void ScopeOfScopesData::addScope(WeakPtr<DedicatedThreadScopeBase> scope,
+                                   ScopePriority priority, duration_t budget,
+                                   std::string name)
+  {
+    scopes.emplace_back(scope_record_t{
+        {}, std::move(scope),
+        ScopeStatistics{.name = std::move(name), .priority = priority, .budget = budget}});
+  }
+
+  void ScopeOfScopesData::addScopeKeepAlive(SharedPtr<DedicatedThreadScopeBase> scope,
+                                            ScopePriority priority, duration_t budget,
+                                            std::string name)
   {
-    scopes.emplace_back(strong_or_weak_ptr{{}, std::move(scope)});
+    scopes.emplace_back(scope_record_t{
+        std::move(scope), {},
+        ScopeStatistics{.name = std::move(name), .priority = priority, .budget = budget}});
   }
 
-  void ScopeOfScopesData::addScopeKeepAlive(SharedPtr<DedicatedThreadScopeBase> scope)
+  std::vector<ScopeStatistics> ScopeOfScopesData::getStatistics() const
   {
-    scopes.emplace_back(strong_or_weak_ptr{std::move(scope), {}});
+    std::vector<ScopeStatistics> result;
+    result.reserve(scopes.size());
+    for(auto& record: scopes) {
+      result.push_back(record.stats);
+    }
+    return result;
   }
 
   void ScopeOfScopesData::execute() noexcept
   {
-    auto it = scopes.begin();
-    while(it != scopes.end()) {
-      auto& [shared, weak] = *it;
-      if(shared) {
-        shared->execute();
-        ++it;
-        continue;
+    using clock_t = DedicatedThreadScopeBase::clock_t;
+    const auto frame_start = clock_t::now();
+
+    // Critical first, then by priority.
+    // Within the same priority, the ones deferred for longer go first.
+    order.resize(scopes.size());
+    for(size_t i = 0; i < order.size(); ++i) {
+      order[i] = i;
+    }
+    std::ranges::stable_sort(order, [this](size_t a, size_t b) {
+      auto& sa = scopes[a].stats;
+      auto& sb = scopes[b].stats;
+      if(sa.priority != sb.priority) {
+        return sa.priority < sb.priority;
       }
+      return sa.deferredFrames > sb.deferredFrames;
+    });
+
+    bool forced_one = false;
+    for(auto i: order) {
+      auto& record = scopes[i];
+      auto& stats  = record.stats;
 
-      auto scope = weak.lock();
-      if(scope) {
-        scope->execute();
-        ++it;
-        continue;
+      if(stats.priority != ScopePriority::CRITICAL) {
+        auto expected = (stats.budget != duration_t{}) ? stats.budget : stats.average;
+        bool fits = (clock_t::now() - frame_start) + expected <= frameBudget;
+        bool starving = stats.deferredFrames >= maxDeferredFrames;
+        if(!fits && !(starving && !forced_one)) {
+          ++stats.deferredFrames;
+          ++stats.deferrals;
+          continue;
+        }
+        if(!fits) {
+          forced_one = true;
+        }
       }
-      it = scopes.erase(it);
+
+      record.gone = !run(record);
     }
+
+    // Remove the scopes whose weak pointer expired.
+    std::erase_if(scopes, [](const scope_record_t& record) { return record.gone; });
   }
 
+  bool ScopeOfScopesData::run(scope_record_t& record)
+  {
+    using clock_t = DedicatedThreadScopeBase::clock_t;
+
+    SharedPtr<DedicatedThreadScopeBase> scope = record.shared;
+    if(!scope) {
+      scope = record.weak.lock();
+      if(!scope) {
+        return false;
+      }
+    }
 
-  void ScopeOfScopes::addScope(WeakPtr<DedicatedThreadScopeBase> scope)
+    const auto start = clock_t::now();
+    scope->execute();
+    const auto elapsed = clock_t::now() - start;
+
+    auto& stats = record.stats;
+    stats.last = elapsed;
+    stats.max  = std::max(stats.max, elapsed);
+    // Exponential moving average, with weight 1/8 for the new sample.
+    stats.average = (stats.executions == 0) ? elapsed
+                                            : stats.average + (elapsed - stats.average) / 8;
+    ++stats.executions;
+    if(stats.budget != duration_t{} && elapsed > stats.budget) {
+      ++stats.overruns;
+    }
+    stats.deferredFrames = 0;
+    return true;
+  }
+
+
+  void ScopeOfScopes::execute() noexcept
+  {
+    // Executes the queued actions (adding scopes, for example)
+    // and then, the sub-scopes.
+    DedicatedThreadScopeT::execute();
+    theStruct.execute();
+
+    // Assigned element by element, so the strings keep their capacity.
+    std::lock_guard lock{statisticsMutex};
+    statistics.resize(theStruct.scopes.size());
+    for(size_t i = 0; i < statistics.size(); ++i) {
+      statistics[i] = theStruct.scopes[i].stats;
+    }
+  }
+
+  std::vector<ScopeStatistics> ScopeOfScopes::getStatistics() const
   {
-    auto lambda = [scope=std::move(scope)](ScopeOfScopesData& data){
-      data.addScope(std::move(scope));
+    std::lock_guard lock{statisticsMutex};
+    return statistics;
+  }
+
+  void ScopeOfScopes::addScope(WeakPtr<DedicatedThreadScopeBase> scope,
+                               ScopePriority priority, duration_t budget,
+                               std::string name)
+  {
+    auto lambda = [scope=std::move(scope), priority, budget, name=std::move(name)]
+        (ScopeOfScopesData& data) {
+      data.addScope(std::move(scope), priority, budget, std::move(name));
       return false;
     };
     newAction(lambda);
   }
 
-  void ScopeOfScopes::addScopeKeepAlive(SharedPtr<DedicatedThreadScopeBase> scope)
+  void ScopeOfScopes::addScopeKeepAlive(SharedPtr<DedicatedThreadScopeBase> scope,
+                                        ScopePriority priority, duration_t budget,
+                                        std::string name)
   {
-    auto lambda = [scope=std::move(scope)](ScopeOfScopesData& data){
-      data.addScopeKeepAlive(std::move(scope));
+    auto lambda = [scope=std::move(scope), priority, budget, name=std::move(name)]
+        (ScopeOfScopesData& data) {
+      data.addScopeKeepAlive(std::move(scope), priority, budget, std::move(name));
       return false;
     };
     newAction(lambda);
   }
+
+  void ScopeOfScopes::setFrameBudget(duration_t budget)
+  {
+    newAction([budget](ScopeOfScopesData& data) {
+      data.setFrameBudget(budget);
+      return false;
+    });
+  }
 }  // namespace Threads
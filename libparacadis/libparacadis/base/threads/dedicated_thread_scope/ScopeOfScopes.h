@@ -26,31 +26,121 @@
 
 #include <libparacadis/base/expected_behaviour/SharedPtr.h>
 
+#include <mutex>
+#include <string>
+#include <vector>
+
 namespace Threads
 {
   class ScopeOfScopes;
 
+  /**
+   * How a sub-scope is treated when the frame is over budget.
+   */
+  enum class ScopePriority {
+    /// Always executed, every frame.
+    CRITICAL,
+    /// Executed when it fits in the frame budget.
+    NORMAL,
+    /// Executed when it fits in the frame budget,
+    /// after all NORMAL scopes.
+    BACKGROUND,
+  };
+
+  /**
+   * Scheduling information for one sub-scope.
+   */
+  struct ScopeStatistics
+  {
+    using duration_t = DedicatedThreadScopeBase::duration_t;
+
+    std::string   name;
+    ScopePriority priority = ScopePriority::CRITICAL;
+    /// Expected execution time. Zero means "use the measured average".
+    duration_t    budget{};
+
+    duration_t    last{};
+    duration_t    average{};
+    duration_t    max{};
+    std::uint64_t executions = 0;
+    /// Number of frames this scope was deferred (accumulated).
+    std::uint64_t deferrals = 0;
+    /// Number of executions that took longer than `budget`.
+    std::uint64_t overruns = 0;
+    /// Number of consecutive frames this scope has been deferred.
+    unsigned      deferredFrames = 0;
+  };
+
   class ScopeOfScopesData
   {
-    using strong_or_weak_ptr =
-      std::pair<SharedPtr<DedicatedThreadScopeBase>,WeakPtr<DedicatedThreadScopeBase>>;
   public:
+    using duration_t = DedicatedThreadScopeBase::duration_t;
+
     ScopeOfScopesData() = default;
 
-    void addScope(WeakPtr<DedicatedThreadScopeBase> scope);
-    void addScopeKeepAlive(SharedPtr<DedicatedThreadScopeBase> scope);
+    void addScope(WeakPtr<DedicatedThreadScopeBase> scope,
+                  ScopePriority priority = ScopePriority::CRITICAL,
+                  duration_t budget = {}, std::string name = {});
+    void addScopeKeepAlive(SharedPtr<DedicatedThreadScopeBase> scope,
+                           ScopePriority priority = ScopePriority::CRITICAL,
+                           duration_t budget = {}, std::string name = {});
+
+    /**
+     * Time the sub-scopes may use in each frame.
+     * CRITICAL sub-scopes are executed anyway, but their time is accounted for.
+     */
+    /// @{
+    void setFrameBudget(duration_t budget) { frameBudget = budget; }
+    duration_t getFrameBudget() const { return frameBudget; }
+    /// @}
+
+    /**
+     * A deferred scope that waits for this number of frames is executed
+     * even if it does not fit the budget. At most one such scope per frame.
+     */
+    void setMaxDeferredFrames(unsigned frames) { maxDeferredFrames = frames; }
+
+    /**
+     * @attention
+     * Only to be called by the dedicated thread.
+     * Other threads call ScopeOfScopes::getStatistics().
+     */
+    std::vector<ScopeStatistics> getStatistics() const;
 
   protected:
     friend class ScopeOfScopes;
     void execute() noexcept;
 
   private:
-    std::vector<strong_or_weak_ptr> scopes;
+    struct scope_record_t
+    {
+      SharedPtr<DedicatedThreadScopeBase> shared;
+      WeakPtr<DedicatedThreadScopeBase>   weak;
+      ScopeStatistics                     stats;
+      bool                                gone = false;
+    };
+
+    std::vector<scope_record_t> scopes;
+    /// Execution order. Kept as a member to avoid reallocating every frame.
+    std::vector<size_t>         order;
+
+    duration_t frameBudget       = std::chrono::milliseconds(8);
+    unsigned   maxDeferredFrames = 30;
+
+    /// @returns `false` if the scope is gone and must be removed.
+    bool run(scope_record_t& record);
   };
 
   /**
    * DedicatedThreadScope that keeps a victor of sub-scopes.
    *
+   * Each sub-scope has a ScopePriority and a time budget.
+   * CRITICAL sub-scopes (the default) are executed every frame.
+   * The others are executed, by priority, while they fit in the frame budget.
+   * The ones that do not fit are deferred to the following frames.
+   * Therefore, the time spent in each frame stays bounded
+   * no matter how many sub-scopes are registered.
+   *
    * @attention
    * There is no removeScope method.
    * If you use addScope(), a weak pointer is kept and the scope
@@ -61,17 +151,42 @@ namespace Threads
     : public DedicatedThreadScopeT<ScopeOfScopesData>
   {
   public:
+    using duration_t = ScopeOfScopesData::duration_t;
+
     ScopeOfScopes() = default;
 
+    void execute() noexcept override;
+
     /**
      * Adds a scope that will be automatically removed when
      * the weak pointer stops being valid.
      */
-    void addScope(WeakPtr<DedicatedThreadScopeBase> scope);
+    void addScope(WeakPtr<DedicatedThreadScopeBase> scope,
+                  ScopePriority priority = ScopePriority::CRITICAL,
+                  duration_t budget = {}, std::string name = {});
 
     /**
      * Adds a scope that will never be removed.
      */
-    void addScopeKeepAlive(SharedPtr<DedicatedThreadScopeBase> scope);
+    void addScopeKeepAlive(SharedPtr<DedicatedThreadScopeBase> scope,
+                           ScopePriority priority = ScopePriority::CRITICAL,
+                           duration_t budget = {}, std::string name = {});
+
+    /**
+     * Sets the time the sub-scopes may use in each frame.
+     */
+    void setFrameBudget(duration_t budget);
+
+    /**
+     * Statistics of the sub-scopes, as of the end of the last frame.
+     * Unlike ScopeOfScopesData::getStatistics(),
+     * it may be called from any thread.
+     */
+    std::vector<ScopeStatistics> getStatistics() const;
+
+  private:
+    mutable std::mutex           statisticsMutex;
+    /// Copied after each frame. Protected by `statisticsMutex`.
+    std::vector<ScopeStatistics> statistics;
   };
 }  // namespace Threads
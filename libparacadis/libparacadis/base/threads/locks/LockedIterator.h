@@ -107,7 +107,8 @@ namespace Threads
     friend constexpr bool operator==(
         const Sentinel& sentinel, const LockedIterator& self)
     {
-      return self == sentinel;
+      // Not `self == sentinel`: in C++20 that may be rewritten as this very call.
+      return self.operator==(sentinel);
     }
 
     LockedIterator& operator++()
@@ -23,53 +23,81 @@
 #include "SignalQueue.h"
 
 #include <libparacadis/base/threads/locks/writer_locks.h>
-#include <libparacadis/base/threads/utils.h>
-
-#include <thread>
+#include <libparacadis/base/threads/thread_pool/ThreadPool.h>
 
 namespace Threads
 {
+  namespace {
+    /// Signals executed before a drain task gives way to other tasks.
+    constexpr size_t drain_batch = 64;
+  }
+
   void SignalQueue::run_thread(const SharedPtr<SignalQueue>& self)
   {
-    auto lambda = [self_weak = self.getWeakPtr(),
-                   callbacks_weak = self->callBacks.getWeakPtr(),
-                   blocked_weak = self->blockedCallBacks.getWeakPtr()] {
-      while(true) {
-        auto callbacks = callbacks_weak.lock();
-        if(!callbacks) {
-          return;
-        }
-        auto blocked = blocked_weak.lock();
-        if(!blocked) {
-          return;
-        }
+    self->drainState->running = true;
+    self->schedule_drain();
+  }
 
-        auto record = callbacks->pull();
-        if(blocked->contains(record.id)) {
-          blocked->at(record.id).push_back(std::move(record.callback));
-        } else {
-          record.callback();
-        }
+  void SignalQueue::schedule_drain() const
+  {
+    if(!drainState->running || drainState->pending == 0) {
+      return;
+    }
+    if(drainState->scheduled.exchange(true)) {
+      return;
+    }
+
+    ThreadPool::global().submit([callbacks_weak = callBacks.getWeakPtr(),
+                                 blocked_weak = blockedCallBacks.getWeakPtr(),
+                                 drain_weak = drainState.getWeakPtr()] {
+      drain(callbacks_weak, blocked_weak, drain_weak);
+    });
+  }
 
-        // We do not hold "self" while blocked in `pull()`.
-        // Because if we have two consumer threads,
-        // we do not them to think "self" is still being used just because
-        // the other consumer thred has a SharedPtr.
-        auto _self = self_weak.lock();
-        if(!_self) {
-          return;
-        }
+  void SignalQueue::drain(const WeakPtr<queue_t>& callbacks_weak,
+                          const WeakPtr<blocked_t>& blocked_weak,
+                          const WeakPtr<drain_t>& drain_weak)
+  {
+    auto callbacks = callbacks_weak.lock();
+    auto blocked = blocked_weak.lock();
+    auto state = drain_weak.lock();
+    if(!callbacks || !blocked || !state) {
+      return;
+    }
+
+    for(size_t i = 0; i < drain_batch && state->pending > 0; ++i) {
+      auto record = callbacks->try_pull();
+      if(!record) {
+        // Spurious failure, or the record is still being pushed.
+        break;
       }
-    };
+      --state->pending;
+
+      if(blocked->contains(record->id)) {
+        blocked->at(record->id).push_back(std::move(record->callback));
+      } else {
+        record->callback();
+      }
+    }
 
-    std::thread thread{std::move(lambda)};
-    Threads::set_thread_name(thread, "signal queue");
-    thread.detach();
+    /*
+     * Resubmit ourselves, instead of looping, so other tasks get their turn.
+     * The flag is cleared before checking `pending` again:
+     * a concurrent push() either sees it cleared and schedules,
+     * or we see its record here.
+     */
+    state->scheduled = false;
+    if(state->pending > 0 && !state->scheduled.exchange(true)) {
+      ThreadPool::global().submit([=] {
+        drain(callbacks_weak, blocked_weak, drain_weak);
+      });
+    }
   }
 
   void SignalQueue::try_run()
   {
     while(auto record = callBacks->try_pull()) {
+      --drainState->pending;
       if(blockedCallBacks->contains(record->id)) {
         blockedCallBacks->at(record->id).push_back(std::move(record->callback));
       } else {
@@ -80,7 +108,10 @@ namespace Threads
 
   void SignalQueue::push(function_t&& callback, void* id)
   {
+    // Counted before it is available, so the counter never underflows.
+    ++drainState->pending;
     callBacks->push(record_t{.id=id, .callback=std::move(callback)});
+    schedule_drain();
   }
 
   void SignalQueue::block(void* id)
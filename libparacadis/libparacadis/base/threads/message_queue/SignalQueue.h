@@ -25,6 +25,7 @@
 #include <libparacadis/base/expected_behaviour/SharedPtr.h>
 #include <libparacadis/base/threads/safe_structs/ThreadSafeQueue.h>
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <semaphore>
@@ -43,17 +44,37 @@ namespace Threads
     /// @attention Not thread safe, while not needed.
     using blocked_t = std::map<void*, std::deque<function_t>>;
 
+    /**
+     * Bookkeeping for draining the queue in ThreadPool::global().
+     */
+    struct drain_t
+    {
+      /// Pushed and not yet pulled records.
+      std::atomic<size_t> pending{0};
+      /// There is a drain task submitted or running.
+      std::atomic<bool>   scheduled{false};
+      /// Set by run_thread().
+      std::atomic<bool>   running{false};
+    };
+
   public:
     SignalQueue()
         : callBacks(std::make_shared<queue_t>(MutexData::LOCKFREE))
-        , blockedCallBacks(std::make_shared<blocked_t>()) {}
+        , blockedCallBacks(std::make_shared<blocked_t>())
+        , drainState(std::make_shared<drain_t>()) {}
 
     /**
-     * Spawns a thread that continually waits for a signal
-     * and executes the corresponding callback.
+     * Executes the signals in ThreadPool::global().
      *
-     * It can be called more than once.
-     * (if we fix the blockedCallBacks thread unsafety)
+     * Whenever there are pending signals, a task is submitted to the pool.
+     * The task executes, in order, a batch of signals
+     * and resubmits itself if there is more to do,
+     * so other tasks get their turn.
+     * There is at most one such task at a time,
+     * so signals are still executed one after the other.
+     *
+     * No thread is kept waiting for signals.
+     * Calling it more than once has no further effect.
      */
     void run_thread(const SharedPtr<SignalQueue>& self);
 
@@ -95,6 +116,14 @@ namespace Threads
     /// @{
     SharedPtr<queue_t> callBacks;
     SharedPtr<blocked_t> blockedCallBacks;
+    SharedPtr<drain_t>   drainState;
     /// @}
+
+    /// Submits a drain task unless there is one already.
+    void schedule_drain() const;
+
+    static void drain(const WeakPtr<queue_t>& callbacks_weak,
+                      const WeakPtr<blocked_t>& blocked_weak,
+                      const WeakPtr<drain_t>& drain_weak);
   };
 }
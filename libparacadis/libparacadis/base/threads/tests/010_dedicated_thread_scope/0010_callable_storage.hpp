@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/base/threads/dedicated_thread_scope/DedicatedThreadScope.h>
+
+#include <vector>
+
+using namespace Threads;
+
+namespace {
+  struct CountingStruct {
+    std::vector<int> calls;
+  };
+
+  using CountingScope = DedicatedThreadScopeT<CountingStruct>;
+}
+
+SCENARIO("Dedicated thread scope callable storage", "[simple]")
+{
+  GIVEN("a scope with three actions, one of them runs only twice")
+  {
+    CountingScope scope;
+    std::vector<int> calls(3, 0);
+    scope.newAction([&calls](CountingStruct&){ ++calls[0]; return true; });
+    scope.newAction([&calls](CountingStruct&){ ++calls[1]; return calls[1] < 2; });
+    scope.newAction([&calls](CountingStruct&){ ++calls[2]; return true; });
+
+    WHEN("we execute it three times")
+    {
+      scope.execute();
+      REQUIRE(scope.callableCount() == 3);
+      scope.execute();
+      scope.execute();
+      THEN("the discarded action is not executed anymore")
+      {
+        REQUIRE(calls == std::vector<int>{3, 2, 3});
+        REQUIRE(scope.callableCount() == 2);
+      }
+    }
+  }
+
+  GIVEN("a scope with actions, and their handles")
+  {
+    CountingScope scope;
+    std::vector<int> calls(3, 0);
+    auto h0 = scope.newAction([&calls](CountingStruct&){ ++calls[0]; return true; });
+    auto h1 = scope.newAction([&calls](CountingStruct&){ ++calls[1]; return true; });
+    auto h2 = scope.newAction([&calls](CountingStruct&){ ++calls[2]; return true; });
+    REQUIRE(h0.isValid());
+    REQUIRE(h0 != h1);
+    REQUIRE(h1 != h2);
+
+    WHEN("we remove one before the dedicated thread registers it")
+    {
+      REQUIRE(scope.removeCallable(h1));
+      REQUIRE(!scope.removeCallable(h1));
+      scope.execute();
+      THEN("it is never executed")
+      {
+        REQUIRE(calls == std::vector<int>{1, 0, 1});
+        REQUIRE(scope.callableCount() == 2);
+        REQUIRE(!scope.removeCallable(h1));
+      }
+      AND_WHEN("we queue a new action")
+      {
+        auto h3 = scope.newAction([](CountingStruct&){ return true; });
+        scope.execute();
+        THEN("the stale handle does not refer to it")
+        {
+          REQUIRE(h3 != h1);
+          REQUIRE(!scope.removeCallable(h1));
+          REQUIRE(scope.callableCount() == 3);
+          REQUIRE(scope.removeCallable(h3));
+        }
+      }
+    }
+
+    WHEN("we remove the first one")
+    {
+      scope.execute();
+      REQUIRE(calls == std::vector<int>{1, 1, 1});
+      REQUIRE(scope.removeCallable(h0));
+      scope.execute();
+      THEN("the others are still executed and handles remain valid")
+      {
+        REQUIRE(calls == std::vector<int>{1, 2, 2});
+        REQUIRE(!scope.removeCallable(h0));
+        REQUIRE(scope.removeCallable(h2));
+        scope.execute();
+        REQUIRE(calls == std::vector<int>{1, 3, 2});
+      }
+      AND_WHEN("we register a new callable")
+      {
+        auto h3 = scope.newAction([](CountingStruct&){ return true; });
+        THEN("the stale handle does not refer to it")
+        {
+          REQUIRE(h3 != h0);
+          REQUIRE(!scope.removeCallable(h0));
+          REQUIRE(scope.removeCallable(h3));
+        }
+      }
+    }
+
+    WHEN("a callable removes another one while executing")
+    {
+      scope.newAction([&scope, h2](CountingStruct&){ scope.removeCallable(h2); return false; });
+      scope.execute();
+      scope.execute();
+      THEN("the removed callable is not executed again")
+      {
+        REQUIRE(calls[2] == 1);
+        REQUIRE(scope.callableCount() == 2);
+      }
+    }
+  }
+
+  GIVEN("a scope with timing enabled")
+  {
+    CountingScope scope;
+    scope.setTiming(true);
+    scope.newAction([](CountingStruct&){ return true; }, "first");
+    scope.newAction([](CountingStruct&){ return true; }, "second");
+
+    WHEN("we execute it")
+    {
+      scope.execute();
+      scope.execute();
+      THEN("each callable has its timing recorded")
+      {
+        auto timings = scope.getTimings();
+        REQUIRE(timings.size() == 2);
+        for(auto& t: timings) {
+          REQUIRE(t.calls == 2);
+          REQUIRE(t.max >= t.last);
+          REQUIRE(t.total >= t.max);
+        }
+        REQUIRE(timings[0].name == "first");
+        REQUIRE(timings[1].name == "second");
+      }
+    }
+  }
+}
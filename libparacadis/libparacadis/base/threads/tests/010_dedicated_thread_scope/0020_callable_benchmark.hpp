@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <libparacadis/base/threads/dedicated_thread_scope/DedicatedThreadScope.h>
+
+using namespace Threads;
+
+namespace {
+  struct BenchmarkStruct {
+    unsigned long long sum = 0;
+  };
+}
+
+TEST_CASE("Dedicated thread scope with 10k callables per frame", "[benchmark]")
+{
+  constexpr int n_callables = 10000;
+
+  DedicatedThreadScopeT<BenchmarkStruct> scope;
+  for(int i = 0; i < n_callables; ++i) {
+    scope.newAction([i](BenchmarkStruct& s){ s.sum += i; return true; });
+  }
+  // Registers the queued actions.
+  scope.execute();
+  REQUIRE(scope.callableCount() == n_callables);
+
+  BENCHMARK("execute one frame")
+  {
+    scope.execute();
+  };
+
+  scope.setTiming(true);
+  BENCHMARK("execute one frame, with timing")
+  {
+    scope.execute();
+  };
+
+  DedicatedThreadScopeT<BenchmarkStruct> churn;
+  BENCHMARK("register, execute and discard 10k callables")
+  {
+    for(int i = 0; i < n_callables; ++i) {
+      churn.newAction([i](BenchmarkStruct& s){ s.sum += i; return false; });
+    }
+    churn.execute();
+  };
+}
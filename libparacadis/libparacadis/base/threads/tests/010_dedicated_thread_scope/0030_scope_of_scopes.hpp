@@ -0,0 +1,180 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/base/threads/dedicated_thread_scope/ScopeOfScopes.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+
+using namespace Threads;
+using namespace std::chrono_literals;
+
+namespace {
+  struct Nothing {};
+
+  /**
+   * A scope that takes some time to execute.
+   */
+  struct SlowScope
+    : public DedicatedThreadScopeT<Nothing>
+  {
+    SlowScope(std::chrono::milliseconds _delay) : delay(_delay) {}
+    void execute() noexcept override
+    {
+      ++count;
+      std::this_thread::sleep_for(delay);
+    }
+    std::chrono::milliseconds delay;
+    int count = 0;
+  };
+}
+
+SCENARIO("Scope of scopes frame budget", "[simple]")
+{
+  GIVEN("a scope of scopes with a critical and two background sub-scopes")
+  {
+    ScopeOfScopes scopes;
+    scopes.setFrameBudget(15ms);
+    auto critical = SharedPtr<SlowScope>::make_shared(10ms);
+    auto bg1 = SharedPtr<SlowScope>::make_shared(10ms);
+    auto bg2 = SharedPtr<SlowScope>::make_shared(10ms);
+    scopes.addScopeKeepAlive(critical, ScopePriority::CRITICAL, {}, "critical");
+    scopes.addScopeKeepAlive(bg1, ScopePriority::BACKGROUND, 10ms, "bg1");
+    scopes.addScopeKeepAlive(bg2, ScopePriority::BACKGROUND, 10ms, "bg2");
+
+    WHEN("we execute some frames")
+    {
+      for(int i = 0; i < 4; ++i) {
+        scopes.execute();
+      }
+      THEN("the critical scope runs every frame and the others are deferred")
+      {
+        REQUIRE(critical->count == 4);
+        REQUIRE(bg1->count == 0);
+        REQUIRE(bg2->count == 0);
+      }
+      THEN("the statistics count executions and deferrals")
+      {
+        const auto statistics = scopes.getStatistics();
+        REQUIRE(statistics.size() == 3);
+        REQUIRE(statistics[0].name == "critical");
+        REQUIRE(statistics[0].executions == 4);
+        REQUIRE(statistics[0].deferrals == 0);
+        REQUIRE(statistics[0].last >= 10ms);
+        for(int i: {1, 2}) {
+          REQUIRE(statistics[i].executions == 0);
+          REQUIRE(statistics[i].deferrals == 4);
+          REQUIRE(statistics[i].deferredFrames == 4);
+        }
+      }
+    }
+
+    WHEN("the frame budget is large enough")
+    {
+      scopes.setFrameBudget(100ms);
+      scopes.execute();
+      THEN("every scope is executed")
+      {
+        REQUIRE(critical->count == 1);
+        REQUIRE(bg1->count == 1);
+        REQUIRE(bg2->count == 1);
+        for(const auto& stats: scopes.getStatistics()) {
+          REQUIRE(stats.executions == 1);
+          REQUIRE(stats.deferrals == 0);
+        }
+      }
+    }
+  }
+
+  GIVEN("a sub-scope that takes longer than its budget")
+  {
+    ScopeOfScopes scopes;
+    scopes.setFrameBudget(100ms);
+    auto slow = SharedPtr<SlowScope>::make_shared(5ms);
+    scopes.addScopeKeepAlive(slow, ScopePriority::NORMAL, 1ms, "slow");
+
+    WHEN("we execute some frames")
+    {
+      for(int i = 0; i < 3; ++i) {
+        scopes.execute();
+      }
+      THEN("every execution is an overrun")
+      {
+        const auto statistics = scopes.getStatistics();
+        REQUIRE(statistics.size() == 1);
+        REQUIRE(statistics[0].executions == 3);
+        REQUIRE(statistics[0].overruns == 3);
+        REQUIRE(statistics[0].max >= 5ms);
+      }
+    }
+  }
+
+  GIVEN("a background scope that never fits the budget")
+  {
+    ScopeOfScopes scopes;
+    scopes.setFrameBudget(1ms);
+    auto bg = SharedPtr<SlowScope>::make_shared(0ms);
+    scopes.addScopeKeepAlive(bg, ScopePriority::BACKGROUND, 10ms);
+
+    WHEN("we execute many frames")
+    {
+      for(int i = 0; i < 100; ++i) {
+        scopes.execute();
+      }
+      THEN("it is still executed from time to time")
+      {
+        REQUIRE(bg->count > 0);
+        REQUIRE(bg->count < 100);
+        const auto statistics = scopes.getStatistics();
+        REQUIRE(statistics.size() == 1);
+        REQUIRE(statistics[0].executions == static_cast<std::uint64_t>(bg->count));
+        REQUIRE(statistics[0].deferrals == static_cast<std::uint64_t>(100 - bg->count));
+        REQUIRE(statistics[0].overruns == 0);
+      }
+    }
+  }
+
+  GIVEN("a sub-scope added through a weak pointer")
+  {
+    ScopeOfScopes scopes;
+    auto scope = SharedPtr<SlowScope>::make_shared(0ms);
+    SharedPtr<DedicatedThreadScopeBase> base = scope;
+    scopes.addScope(base);
+    scopes.execute();
+    REQUIRE(scope->count == 1);
+    REQUIRE(scopes.getStatistics().size() == 1);
+
+    WHEN("the sub-scope is destroyed")
+    {
+      scope.reset();
+      base.reset();
+      scopes.execute();
+      THEN("it is simply removed")
+      {
+        REQUIRE(scopes.getStatistics().empty());
+      }
+    }
+  }
+}
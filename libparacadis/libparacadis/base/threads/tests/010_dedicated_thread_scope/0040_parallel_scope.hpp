@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/base/threads/dedicated_thread_scope/ParallelScope.h>
+#include <libparacadis/base/threads/thread_pool/ThreadPool.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace Threads;
+
+namespace {
+  struct PlotStruct {
+    std::vector<int> applied;
+    std::thread::id  thread;
+  };
+
+  /// Executes the scope until @a done, or gives up.
+  template<typename Scope, typename Pred>
+  bool execute_until(Scope& scope, Pred&& done)
+  {
+    for(int i = 0; i < 1000; ++i) {
+      scope.execute();
+      if(done()) {
+        return true;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return false;
+  }
+}
+
+SCENARIO("Parallel scope computes in the pool and applies in the dedicated thread", "[simple]")
+{
+  GIVEN("a parallel scope")
+  {
+    ThreadPool pool(2);
+    ParallelScopeT<PlotStruct> scope(pool);
+
+    WHEN("we add an action that is applied only once")
+    {
+      std::atomic<std::thread::id> compute_thread;
+      scope.newParallelAction(
+          [&compute_thread]{ compute_thread = std::this_thread::get_id(); return 42; },
+          [](PlotStruct& s, int value){
+            s.applied.push_back(value);
+            s.thread = std::this_thread::get_id();
+            return false;
+          });
+
+      std::vector<int>* applied = nullptr;
+      std::thread::id apply_thread;
+      scope.newAction([&](PlotStruct& s){
+        applied = &s.applied;
+        apply_thread = s.thread;
+        return true;
+      });
+
+      THEN("the result is applied by the thread that executes the scope")
+      {
+        REQUIRE(execute_until(scope, [&]{ return applied && !applied->empty(); }));
+        scope.execute();
+        REQUIRE(*applied == std::vector<int>{42});
+        REQUIRE(apply_thread == std::this_thread::get_id());
+        REQUIRE(compute_thread.load() != std::this_thread::get_id());
+      }
+    }
+
+    WHEN("we add an action that keeps computing")
+    {
+      int counter = 0;
+      std::vector<int>* applied = nullptr;
+      scope.newAction([&](PlotStruct& s){ applied = &s.applied; return true; });
+      scope.newParallelAction(
+          [&counter]{ return ++counter; },
+          [](PlotStruct& s, int value){
+            s.applied.push_back(value);
+            return value < 3;
+          });
+
+      THEN("it is computed and applied again until apply returns false")
+      {
+        REQUIRE(execute_until(scope, [&]{ return applied && applied->size() == 3; }));
+        for(int i = 0; i < 10; ++i) {
+          scope.execute();
+        }
+        REQUIRE(*applied == std::vector<int>{1, 2, 3});
+      }
+    }
+
+    WHEN("we add an action whose computation is trivial and keeps computing")
+    {
+      std::vector<int>* applied = nullptr;
+      scope.newAction([&](PlotStruct& s){ applied = &s.applied; return true; });
+      scope.newParallelAction(
+          []{ return 0; },
+          [](PlotStruct& s, int value){
+            s.applied.push_back(value);
+            return true;
+          });
+
+      THEN("it is applied at most once per execute()")
+      {
+        REQUIRE(execute_until(scope, [&]{ return applied && !applied->empty(); }));
+        bool at_most_once = true;
+        for(int i = 0; i < 100; ++i) {
+          const auto before = applied->size();
+          // Gives the pool time to finish the computation.
+          std::this_thread::sleep_for(std::chrono::microseconds(200));
+          scope.execute();
+          at_most_once = at_most_once && applied->size() <= before + 1;
+        }
+        REQUIRE(at_most_once);
+        REQUIRE(applied->size() > 1);
+      }
+    }
+
+    WHEN("the computation throws")
+    {
+      std::atomic<int> attempts = 0;
+      std::vector<std::string> errors;
+      bool applied = false;
+      scope.newParallelAction(
+          [&attempts]() -> int {
+            ++attempts;
+            throw std::runtime_error("no data");
+          },
+          [&applied](PlotStruct&, int){ applied = true; return false; },
+          [&errors](PlotStruct&, std::exception_ptr error){
+            try {
+              std::rethrow_exception(error);
+            } catch(const std::runtime_error& e) {
+              errors.push_back(e.what());
+            }
+            return errors.size() < 2;
+          });
+
+      THEN("the error reaches the dedicated thread, and the action may retry")
+      {
+        REQUIRE(execute_until(scope, [&]{ return errors.size() == 2; }));
+        for(int i = 0; i < 10; ++i) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          scope.execute();
+        }
+        REQUIRE(errors == std::vector<std::string>{"no data", "no data"});
+        REQUIRE(attempts == 2);
+        REQUIRE(!applied);
+      }
+    }
+
+    WHEN("the computation throws, and there is no error handler")
+    {
+      std::atomic<int> attempts = 0;
+      scope.newParallelAction(
+          [&attempts]() -> int {
+            ++attempts;
+            throw std::runtime_error("no data");
+          },
+          [](PlotStruct&, int){ return true; });
+
+      THEN("the action ends")
+      {
+        for(int i = 0; i < 20; ++i) {
+          std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          scope.execute();
+        }
+        REQUIRE(attempts == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,30 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <libparacadis/base/threads/dedicated_thread_scope/DedicatedThreadScope.h>
+#include <libparacadis/base/threads/dedicated_thread_scope/ScopeOfScopes.h>
+#include <libparacadis/base/threads/dedicated_thread_scope/ParallelScope.h>
+
+#include "0010_callable_storage.hpp"
+#include "0020_callable_benchmark.hpp"
+#include "0030_scope_of_scopes.hpp"
+#include "0040_parallel_scope.hpp"
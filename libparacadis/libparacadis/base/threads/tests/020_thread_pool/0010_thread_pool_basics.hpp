@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/base/threads/thread_pool/ThreadPool.h>
+
+#include <atomic>
+#include <chrono>
+#include <latch>
+
+using namespace Threads;
+
+SCENARIO("Thread pool executes submitted tasks", "[simple]")
+{
+  GIVEN("a pool with four workers")
+  {
+    ThreadPool pool(4);
+    REQUIRE(pool.size() == 4);
+
+    WHEN("we submit many tasks from outside the pool")
+    {
+      constexpr int n = 10000;
+      std::atomic<int> count{0};
+      std::latch done{n};
+      for(int i = 0; i < n; ++i) {
+        pool.submit([&]{ ++count; done.count_down(); });
+      }
+      done.wait();
+      THEN("all of them are executed")
+      {
+        REQUIRE(count == n);
+      }
+    }
+
+    WHEN("tasks submit other tasks")
+    {
+      constexpr int n = 100;
+      std::atomic<int> count{0};
+      std::latch done{n * n};
+      for(int i = 0; i < n; ++i) {
+        pool.submit([&]{
+          for(int j = 0; j < n; ++j) {
+            pool.submit([&]{ ++count; done.count_down(); });
+          }
+        });
+      }
+      done.wait();
+      THEN("the nested tasks are executed (and stolen) as well")
+      {
+        REQUIRE(count == n * n);
+      }
+    }
+  }
+}
+
+SCENARIO("Thread pool runs delayed tasks after their deadline", "[simple]")
+{
+  using namespace std::chrono_literals;
+  using clock = std::chrono::steady_clock;
+
+  GIVEN("an idle pool with two workers")
+  {
+    ThreadPool pool(2);
+
+    WHEN("we submit delayed tasks out of order")
+    {
+      const auto start = clock::now();
+      std::atomic<int> order{0};
+      int first = -1, second = -1;
+      clock::duration first_delay{}, second_delay{};
+      std::latch done{2};
+      pool.submitAfter(60ms, [&]{ second_delay = clock::now() - start; second = order++; done.count_down(); });
+      pool.submitAfter(20ms, [&]{ first_delay = clock::now() - start; first = order++; done.count_down(); });
+      done.wait();
+      THEN("they run in deadline order, not before their deadline")
+      {
+        REQUIRE(first == 0);
+        REQUIRE(second == 1);
+        REQUIRE(first_delay >= 20ms);
+        REQUIRE(second_delay >= 60ms);
+      }
+    }
+  }
+}
@@ -0,0 +1,142 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/base/threads/thread_pool/TaskGroup.h>
+#include <libparacadis/base/threads/message_queue/SignalQueue.h>
+
+#include <atomic>
+#include <latch>
+#include <stdexcept>
+#include <vector>
+
+using namespace Threads;
+
+SCENARIO("Task groups wait for and cancel their tasks", "[simple]")
+{
+  GIVEN("a pool with two workers")
+  {
+    ThreadPool pool(2);
+
+    WHEN("a group runs many tasks")
+    {
+      constexpr int n = 1000;
+      std::atomic<int> count{0};
+      TaskGroup group{pool};
+      for(int i = 0; i < n; ++i) {
+        group.run([&]{ ++count; });
+      }
+      group.wait();
+      THEN("wait() returns after all of them are executed")
+      {
+        REQUIRE(count == n);
+        REQUIRE(pool.getMetrics().executed >= n);
+      }
+    }
+
+    WHEN("tasks wait for nested groups")
+    {
+      constexpr int n = 16;
+      std::atomic<int> count{0};
+      TaskGroup outer{pool};
+      for(int i = 0; i < n; ++i) {
+        outer.run([&]{
+          // More waiting tasks than workers: waiting must help.
+          TaskGroup inner{pool};
+          for(int j = 0; j < n; ++j) {
+            inner.run([&]{ ++count; });
+          }
+          inner.wait();
+        });
+      }
+      outer.wait();
+      THEN("there is no deadlock")
+      {
+        REQUIRE(count == n * n);
+      }
+    }
+
+    WHEN("the group is cancelled before the tasks start")
+    {
+      std::latch started{pool.size()};
+      std::latch release{1};
+      std::atomic<int> count{0};
+      TaskGroup blocker{pool};
+      for(unsigned i = 0; i < pool.size(); ++i) {
+        blocker.run([&]{ started.count_down(); release.wait(); });
+      }
+      started.wait();
+
+      TaskGroup group{pool};
+      for(int i = 0; i < 100; ++i) {
+        group.run([&]{ ++count; });
+      }
+      group.cancel();
+      release.count_down();
+      group.wait();
+      THEN("they are skipped")
+      {
+        REQUIRE(group.isCancelled());
+        REQUIRE(count == 0);
+      }
+    }
+
+    WHEN("a task throws")
+    {
+      TaskGroup group{pool};
+      group.run([]{ throw std::runtime_error("failed"); });
+      THEN("wait() rethrows and the group is cancelled")
+      {
+        REQUIRE_THROWS_AS(group.wait(), std::runtime_error);
+        REQUIRE(group.isCancelled());
+      }
+    }
+  }
+}
+
+SCENARIO("Signal queues are drained by the global pool", "[simple]")
+{
+  GIVEN("a running signal queue")
+  {
+    auto queue = SharedPtr<SignalQueue>::make_shared();
+    queue->run_thread(queue);
+
+    WHEN("we push many signals")
+    {
+      constexpr int n = 1000;
+      std::vector<int> order;
+      std::latch done{n};
+      for(int i = 0; i < n; ++i) {
+        queue->push([&, i]{ order.push_back(i); done.count_down(); }, nullptr);
+      }
+      done.wait();
+      THEN("they are executed in order")
+      {
+        REQUIRE(order.size() == n);
+        for(int i = 0; i < n; ++i) {
+          REQUIRE(order[i] == i);
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "TaskGroup.h"
+
+#include <chrono>
+
+namespace Threads
+{
+  TaskGroup::TaskGroup(ThreadPool& pool)
+      : pool(pool)
+      , state(std::make_shared<state_t>())
+  {}
+
+  TaskGroup::~TaskGroup()
+  {
+    try {
+      wait();
+    } catch(...) {
+      // Nobody waited for it, so nobody is interested.
+    }
+  }
+
+  void TaskGroup::wait()
+  {
+    using namespace std::chrono_literals;
+
+    while(state->outstanding > 0) {
+      if(pool.tryRunOne()) {
+        continue;
+      }
+      // Our tasks are running elsewhere, but they may submit more.
+      std::unique_lock lock{state->mutex};
+      state->done.wait_for(lock, 1ms, [this] { return state->outstanding == 0; });
+    }
+
+    std::exception_ptr error;
+    {
+      std::scoped_lock lock{state->mutex};
+      std::swap(error, state->error);
+    }
+    if(error) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  void TaskGroup::finished(state_t& state)
+  {
+    std::scoped_lock lock{state.mutex};
+    if(--state.outstanding == 0) {
+      state.done.notify_all();
+    }
+  }
+
+  void TaskGroup::failed(state_t& state, std::exception_ptr error)
+  {
+    std::scoped_lock lock{state.mutex};
+    if(!state.error) {
+      state.error = std::move(error);
+    }
+    state.token.cancel();
+  }
+}  // namespace Threads
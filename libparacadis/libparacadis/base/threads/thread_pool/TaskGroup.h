@@ -0,0 +1,105 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+namespace Threads
+{
+  /**
+   * Tells long tasks they should give up.
+   *
+   * Tasks in a TaskGroup that have not started when the group is cancelled
+   * are skipped. Tasks already running may poll isCancelled().
+   */
+  class CancellationToken
+  {
+  public:
+    CancellationToken() : flag(std::make_shared<std::atomic<bool>>(false)) {}
+
+    bool isCancelled() const { return *flag; }
+    void cancel() { *flag = true; }
+
+  private:
+    std::shared_ptr<std::atomic<bool>> flag;
+  };
+
+  /**
+   * A set of tasks submitted to a ThreadPool that can be waited for
+   * and cancelled together.
+   *
+   * The first exception thrown by a task cancels the group
+   * and is rethrown by wait().
+   *
+   * @attention
+   * The destructor waits for the tasks.
+   */
+  class TaskGroup
+  {
+  public:
+    explicit TaskGroup(ThreadPool& pool = ThreadPool::global());
+    ~TaskGroup();
+
+    TaskGroup(const TaskGroup&) = delete;
+    TaskGroup& operator=(const TaskGroup&) = delete;
+
+    template<typename F>
+    void run(F&& f);
+
+    /**
+     * Blocks until every task has finished or was skipped.
+     *
+     * While waiting, the calling thread executes queued tasks of the pool.
+     * So it is safe to wait from inside a pool task.
+     */
+    void wait();
+
+    void cancel() { state->token.cancel(); }
+    bool isCancelled() const { return state->token.isCancelled(); }
+    const CancellationToken& getToken() const { return state->token; }
+
+  private:
+    struct state_t
+    {
+      CancellationToken       token;
+      std::atomic<size_t>     outstanding{0};
+      std::mutex              mutex;
+      std::condition_variable done;
+      std::exception_ptr      error;
+    };
+
+    ThreadPool&              pool;
+    std::shared_ptr<state_t> state;
+
+    static void finished(state_t& state);
+    static void failed(state_t& state, std::exception_ptr error);
+  };
+}  // namespace Threads
+
+#include "TaskGroup.hpp"
@@ -0,0 +1,44 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "TaskGroup.h"
+
+namespace Threads
+{
+  template<typename F>
+  void TaskGroup::run(F&& f)
+  {
+    ++state->outstanding;
+    pool.submit([state = state, f = std::forward<F>(f)]() mutable {
+      if(!state->token.isCancelled()) {
+        try {
+          f();
+        } catch(...) {
+          failed(*state, std::current_exception());
+        }
+      }
+      finished(*state);
+    });
+  }
+}  // namespace Threads
@@ -0,0 +1,270 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "ThreadPool.h"
+
+#include <libparacadis/base/threads/utils.h>
+
+#include <algorithm>
+#include <exception>
+#include <format>
+#include <iostream>
+
+namespace Threads
+{
+  namespace {
+    thread_local const ThreadPool* current_pool = nullptr;
+    thread_local unsigned current_index = 0;
+
+    /// Heap order of the delayed tasks: the earliest deadline on top.
+    constexpr auto later_deadline = [](const auto& a, const auto& b) { return a.deadline > b.deadline; };
+  }
+
+  ThreadPool::ThreadPool(Options options)
+  {
+    auto n_threads = options.threads;
+    if(n_threads == 0) {
+      n_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    workers.reserve(n_threads);
+    for(unsigned i = 0; i < n_threads; ++i) {
+      workers.emplace_back(std::make_unique<Worker>());
+    }
+    // Only start after all the workers exist, because they steal from each other.
+    for(unsigned i = 0; i < n_threads; ++i) {
+      auto& thread = workers[i]->thread;
+      thread = std::thread{[this, i]{ run(i); }};
+      set_thread_name(thread, std::format("pool worker {}", i));
+      if(options.pinThreads) {
+        set_thread_affinity(thread, i);
+      }
+    }
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    {
+      std::scoped_lock lock{sleepMutex};
+      stopping = true;
+    }
+    sleepCondition.notify_all();
+    for(auto& worker: workers) {
+      worker->thread.join();
+    }
+  }
+
+  namespace {
+    ThreadPool::Options global_options;
+  }
+
+  ThreadPool& ThreadPool::global()
+  {
+    static ThreadPool pool{global_options};
+    return pool;
+  }
+
+  void ThreadPool::setGlobalOptions(Options options)
+  {
+    global_options = options;
+  }
+
+  PoolMetrics ThreadPool::getMetrics() const
+  {
+    return {.workers  = size(),
+            .busy     = busy,
+            .queued   = pending,
+            .executed = executed,
+            .stolen   = stolen,
+            .busyTime = std::chrono::nanoseconds(busyNanoseconds)};
+  }
+
+  int ThreadPool::currentWorker() const
+  {
+    return (current_pool == this) ? int(current_index) : -1;
+  }
+
+  void ThreadPool::submit(task_t task)
+  {
+    int index = currentWorker();
+    if(index < 0) {
+      index = nextWorker++ % workers.size();
+    }
+
+    {
+      // Avoids a lost wakeup between a worker checking `pending`
+      // and going to sleep.
+      std::scoped_lock lock{sleepMutex};
+      // Counted before it is published, so a worker that runs it
+      // right away never takes `pending` below zero.
+      ++pending;
+    }
+    auto& worker = *workers[index];
+    {
+      std::scoped_lock lock{worker.mutex};
+      worker.tasks.emplace_back(std::move(task));
+    }
+    sleepCondition.notify_one();
+  }
+
+  void ThreadPool::submitAfter(std::chrono::steady_clock::duration delay, task_t task)
+  {
+    {
+      std::scoped_lock lock{sleepMutex};
+      delayed.push_back({clock_t::now() + delay, std::move(task)});
+      std::ranges::push_heap(delayed, later_deadline);
+      nextDeadline = delayed.front().deadline.time_since_epoch().count();
+    }
+    // A sleeping worker has to recompute how long to sleep.
+    sleepCondition.notify_one();
+  }
+
+  void ThreadPool::promoteDue(unsigned index)
+  {
+    const auto now = clock_t::now();
+    auto& worker = *workers[index];
+    while(!delayed.empty() && delayed.front().deadline <= now) {
+      std::ranges::pop_heap(delayed, later_deadline);
+      // Before it is published, as in submit().
+      ++pending;
+      {
+        std::scoped_lock lock{worker.mutex};
+        worker.tasks.emplace_back(std::move(delayed.back().task));
+      }
+      delayed.pop_back();
+    }
+    nextDeadline = delayed.empty() ? clock_t::time_point::max().time_since_epoch().count()
+                                   : delayed.front().deadline.time_since_epoch().count();
+  }
+
+  ThreadPool::task_t ThreadPool::pop(unsigned index)
+  {
+    auto& worker = *workers[index];
+    std::scoped_lock lock{worker.mutex};
+    if(worker.tasks.empty()) {
+      return {};
+    }
+    auto task = std::move(worker.tasks.back());
+    worker.tasks.pop_back();
+    return task;
+  }
+
+  ThreadPool::task_t ThreadPool::steal(unsigned thief, bool include_thief)
+  {
+    const auto n = workers.size();
+    for(size_t k = include_thief ? 0 : 1; k < n; ++k) {
+      auto& victim = *workers[(thief + k) % n];
+      std::unique_lock lock{victim.mutex, std::try_to_lock};
+      if(!lock || victim.tasks.empty()) {
+        continue;
+      }
+      auto task = std::move(victim.tasks.front());
+      victim.tasks.pop_front();
+      ++stolen;
+      return task;
+    }
+    return {};
+  }
+
+  bool ThreadPool::tryRunOne()
+  {
+    if(pending == 0) {
+      return false;
+    }
+
+    int index = currentWorker();
+    task_t task;
+    if(index >= 0) {
+      task = pop(index);
+      if(!task) {
+        task = steal(index);
+      }
+    } else {
+      // Not a worker: steal from anybody.
+      task = steal(nextWorker++ % workers.size(), true);
+    }
+    if(!task) {
+      return false;
+    }
+    execute(task);
+    return true;
+  }
+
+  void ThreadPool::execute(task_t& task)
+  {
+    using clock_t = std::chrono::steady_clock;
+
+    --pending;
+    ++busy;
+    const auto start = clock_t::now();
+    try {
+      task();
+    } catch(const std::exception& e) {
+      std::cerr << "Exception caught in thread pool: " << e.what() << ".\n";
+    } catch(...) {
+      std::cerr << "Unknown exception caught in thread pool.\n";
+    }
+    const auto elapsed = clock_t::now() - start;
+    busyNanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    ++executed;
+    --busy;
+  }
+
+  void ThreadPool::run(unsigned index)
+  {
+    current_pool  = this;
+    current_index = index;
+
+    while(true) {
+      if(clock_t::now().time_since_epoch().count() >= nextDeadline) {
+        std::scoped_lock lock{sleepMutex};
+        promoteDue(index);
+      }
+
+      auto task = pop(index);
+      if(!task) {
+        task = steal(index);
+      }
+
+      if(task) {
+        execute(task);
+        continue;
+      }
+
+      std::unique_lock lock{sleepMutex};
+      if(stopping) {
+        return;
+      }
+      promoteDue(index);
+      if(pending > 0) {
+        continue;
+      }
+      if(delayed.empty()) {
+        sleepCondition.wait(lock);
+      } else {
+        // A copy: submitAfter() may reallocate `delayed` while we sleep.
+        const auto deadline = delayed.front().deadline;
+        sleepCondition.wait_until(lock, deadline);
+      }
+    }
+  }
+}  // namespace Threads
@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Threads
+{
+  /**
+   * Utilization of a ThreadPool.
+   */
+  struct PoolMetrics
+  {
+    unsigned      workers = 0;
+    /// Workers executing a task right now.
+    unsigned      busy = 0;
+    /// Tasks waiting to be executed.
+    size_t        queued = 0;
+    std::uint64_t executed = 0;
+    /// Tasks executed by a worker other than the one they were queued to.
+    std::uint64_t stolen = 0;
+    /// Accumulated time spent executing tasks, by all workers.
+    std::chrono::nanoseconds busyTime{};
+  };
+
+  /**
+   * A pool of worker threads that execute submitted tasks.
+   *
+   * Each worker has its own deque of tasks.
+   * Tasks submitted by a worker go to its own deque
+   * and the worker executes them in LIFO order (hot caches).
+   * When a worker runs out of tasks, it steals the oldest task
+   * from the other workers' deques.
+   *
+   * The library has one pool, ThreadPool::global().
+   * Every subsystem (signal queues, tessellation, etc.)
+   * is supposed to submit work to it, instead of creating threads.
+   *
+   * @attention
+   * Tasks shall not block waiting for other tasks.
+   * There is a limited number of workers.
+   * To wait for a set of tasks, use a TaskGroup:
+   * the waiting thread helps executing tasks.
+   */
+  class ThreadPool
+  {
+  public:
+    using task_t = std::move_only_function<void()>;
+
+    struct Options
+    {
+      /// Number of workers. Zero means std::thread::hardware_concurrency().
+      unsigned threads = 0;
+      /// Pins worker `i` to CPU `i`.
+      bool     pinThreads = false;
+    };
+
+    explicit ThreadPool(Options options);
+    explicit ThreadPool(unsigned n_threads = 0) : ThreadPool(Options{.threads = n_threads}) {}
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * Queues a task. Never blocks (except for very short lived mutexes).
+     */
+    void submit(task_t task);
+
+    /**
+     * Queues a task after @a delay.
+     *
+     * Nobody waits for the delay: the task is queued by the first worker
+     * that notices it is due (workers sleep until the earliest deadline).
+     */
+    void submitAfter(std::chrono::steady_clock::duration delay, task_t task);
+
+    /**
+     * Executes one queued task in the calling thread, if there is any.
+     *
+     * @returns `false` if there was nothing to execute.
+     */
+    bool tryRunOne();
+
+    unsigned size() const { return workers.size(); }
+
+    PoolMetrics getMetrics() const;
+
+    /**
+     * The library-wide pool.
+     */
+    static ThreadPool& global();
+
+    /**
+     * Sets the options for the global() pool.
+     *
+     * @attention
+     * Has no effect after global() is called for the first time.
+     */
+    static void setGlobalOptions(Options options);
+
+  private:
+    struct Worker
+    {
+      std::mutex          mutex;
+      std::deque<task_t>  tasks;
+      std::thread         thread;
+    };
+
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    /// Tasks not yet taken by any worker.
+    std::atomic<size_t>     pending{0};
+    std::atomic<unsigned>   nextWorker{0};
+    std::atomic<bool>       stopping{false};
+
+    std::mutex              sleepMutex;
+    std::condition_variable sleepCondition;
+
+    using clock_t = std::chrono::steady_clock;
+    struct delayed_t
+    {
+      clock_t::time_point deadline;
+      task_t              task;
+    };
+    /// Heap ordered by deadline. Protected by `sleepMutex`.
+    std::vector<delayed_t> delayed;
+    /// Earliest deadline in `delayed`, so workers do not lock to check.
+    std::atomic<clock_t::rep> nextDeadline{clock_t::time_point::max().time_since_epoch().count()};
+
+    std::atomic<unsigned>      busy{0};
+    std::atomic<std::uint64_t> executed{0};
+    std::atomic<std::uint64_t> stolen{0};
+    std::atomic<std::uint64_t> busyNanoseconds{0};
+
+    void   run(unsigned index);
+    /**
+     * Moves the due delayed tasks to the worker's deque.
+     * @attention Call it holding `sleepMutex`.
+     */
+    void   promoteDue(unsigned index);
+    void   execute(task_t& task);
+    task_t pop(unsigned index);
+    task_t steal(unsigned thief, bool include_thief = false);
+
+    /// Index of the current thread's worker, if it belongs to this pool.
+    int currentWorker() const;
+  };
+}  // namespace Threads
@@ -22,6 +22,8 @@
 
 #include "utils.h"
 
+#include <algorithm>
+
 // TODO: make it portable!
 #include <pthread.h>
 
@@ -38,4 +40,18 @@ namespace Threads
     std::string trimed{name.substr(0, 15)};
     pthread_setname_np(thread.native_handle(), trimed.c_str());
   }
+
+  void set_thread_affinity(std::thread& thread, unsigned cpu)
+  {
+    const auto n_cpus = std::max(1u, std::thread::hardware_concurrency());
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    CPU_SET(cpu % n_cpus, &cpus);
+    pthread_setaffinity_np(thread.native_handle(), sizeof(cpus), &cpus);
+  }
+
+  PoolMetrics pool_metrics()
+  {
+    return ThreadPool::global().getMetrics();
+  }
 }
@@ -22,6 +22,8 @@
 
 #pragma once
 
+#include <libparacadis/base/threads/thread_pool/ThreadPool.h>
+
 #include <string_view>
 #include <thread>
 
@@ -29,4 +31,15 @@ namespace Threads
 {
   void set_thread_name(std::thread& thread, std::string_view name);
   void set_thread_name(std::string_view name);
+
+  /**
+   * Restricts the thread to run on the given CPU only.
+   * CPUs beyond the available ones wrap around.
+   */
+  void set_thread_affinity(std::thread& thread, unsigned cpu);
+
+  /**
+   * Utilization of ThreadPool::global().
+   */
+  PoolMetrics pool_metrics();
 }
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "AnalyticTessellation.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+using namespace Mesh;
+
+namespace {
+  /**
+   * Largest angle (radians) of a chord of a circle of @a radius
+   * whose deviation, \f$r(1 - \cos(\theta/2))\f$, is within @a tolerance.
+   */
+  double chord_angle(double radius, double tolerance)
+  {
+    const double ratio = std::min(tolerance / radius, 1.);
+    return 2 * std::acos(1 - ratio);
+  }
+
+  /**
+   * Cosines and sines of `first + k * step`, for k in [0, count].
+   *
+   * Each value is a rotation of the previous one
+   * (angle addition formulas), instead of a call to std::cos and std::sin.
+   * The last one is computed exactly, so closed loops close.
+   */
+  void trig_table(double first, double step, index_t count,
+                  std::vector<double>& cos_out, std::vector<double>& sin_out)
+  {
+    cos_out.resize(count + 1);
+    sin_out.resize(count + 1);
+    const double cos_step = std::cos(step);
+    const double sin_step = std::sin(step);
+    double c = std::cos(first);
+    double s = std::sin(first);
+    for(index_t k = 0; k < count; ++k) {
+      cos_out[k] = c;
+      sin_out[k] = s;
+      const double next = c * cos_step - s * sin_step;
+      s = s * cos_step + c * sin_step;
+      c = next;
+    }
+    cos_out[count] = std::cos(first + count * step);
+    sin_out[count] = std::sin(first + count * step);
+  }
+}
+
+
+index_t Mesh::arc_segments(real_t angle, real_t step, const TessellationParameters& parameters)
+{
+  constexpr double quarter = std::numbers::pi / 2;
+  const index_t spans = std::max<index_t>(1, index_t(std::ceil(angle / quarter - 1e-9)));
+  const index_t segments = index_t(std::ceil(angle / step - 1e-9));
+  return std::clamp<index_t>(segments,
+                             spans * parameters.minSegmentsPerSpan,
+                             spans * parameters.maxSegmentsPerSpan);
+}
+
+
+SphereGrid Mesh::sphere_grid(const Document::AnalyticSphere& sphere,
+                             const TessellationParameters& parameters)
+{
+  constexpr double pi = std::numbers::pi;
+  constexpr size_t entries = 6;
+
+  /*
+   * The triangles of a grid cell of angular side θ have a circumradius
+   * of about θ/√2 (in angle). They deviate from the sphere
+   * as much as a chord of twice that angle.
+   */
+  const double step = std::sqrt(2.) / 2
+                      * chord_angle(sphere.radius, parameters.chordalTolerance);
+  const index_t longitudes = arc_segments(2 * pi, step, parameters);
+  const index_t latitudes = arc_segments(pi, step, parameters);
+
+  std::vector<double> cos_lon, sin_lon, cos_lat, sin_lat;
+  trig_table(0, 2 * pi / longitudes, longitudes, cos_lon, sin_lon);
+  trig_table(-pi / 2, pi / latitudes, latitudes, cos_lat, sin_lat);
+  // The poles.
+  cos_lat.front() = cos_lat.back() = 0;
+  sin_lat.front() = -1;
+  sin_lat.back() = 1;
+
+  SphereGrid result;
+  result.np = {longitudes + 1, latitudes + 1};
+  result.positions_normals.resize(entries * result.np[0] * result.np[1]);
+
+  const auto [cx, cy, cz] = sphere.center;
+  const double r = sphere.radius;
+  float* out = result.positions_normals.data();
+  for(index_t j = 0; j < result.np[1]; ++j) {
+    const double cos_phi = cos_lat[j];
+    const double sin_phi = sin_lat[j];
+    // Independent iterations, with no calls: the compiler vectorizes them.
+    for(index_t i = 0; i < result.np[0]; ++i) {
+      const double nx = cos_phi * cos_lon[i];
+      const double ny = cos_phi * sin_lon[i];
+      const double nz = sin_phi;
+      out[0] = float(cx + r * nx);
+      out[1] = float(cy + r * ny);
+      out[2] = float(cz + r * nz);
+      out[3] = float(nx);
+      out[4] = float(ny);
+      out[5] = float(nz);
+      out += entries;
+    }
+  }
+  return result;
+}
+
+
+std::vector<float> Mesh::circle_points(const Document::AnalyticCircle& circle,
+                                       const TessellationParameters& parameters)
+{
+  constexpr double pi = std::numbers::pi;
+  constexpr size_t entries = 3;
+
+  const index_t segments = arc_segments(
+      2 * pi, chord_angle(circle.radius, parameters.chordalTolerance), parameters);
+
+  std::vector<double> cos_t, sin_t;
+  trig_table(0, 2 * pi / segments, segments, cos_t, sin_t);
+
+  const auto& n = circle.normal;
+  const auto& x = circle.xdir;
+  // y = n × x
+  const std::array<double, 3> y{n[1] * x[2] - n[2] * x[1],
+                                n[2] * x[0] - n[0] * x[2],
+                                n[0] * x[1] - n[1] * x[0]};
+  const double r = circle.radius;
+
+  std::vector<float> result(entries * (segments + 1));
+  float* out = result.data();
+  for(index_t k = 0; k <= segments; ++k) {
+    const double a = r * cos_t[k];
+    const double b = r * sin_t[k];
+    for(size_t d = 0; d < 3; ++d) {
+      *out++ = float(circle.center[d] + a * x[d] + b * y[d]);
+    }
+  }
+  // The loop closes exactly.
+  std::copy_n(result.begin(), entries, result.end() - entries);
+  return result;
+}
@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "Tessellation.h"
+
+#include <array>
+#include <vector>
+
+/*
+ * Analytic primitives (see Document::AnalyticShape) are tessellated
+ * in closed form, instead of evaluating their NURBS:
+ * the positions and normals are products of tables of sines and cosines.
+ */
+namespace Mesh
+{
+  /**
+   * Number of segments for an arc of @a angle radians,
+   * so no segment spans more than @a step radians.
+   *
+   * It is limited like adaptive_samples(),
+   * counting each quarter of a turn as a knot span
+   * (as in the NURBS of circles and spheres).
+   */
+  index_t arc_segments(real_t angle, real_t step, const TessellationParameters& parameters);
+
+  /**
+   * The points of a sphere on a grid of longitudes (varying faster)
+   * and latitudes, from the south pole to the north pole.
+   *
+   * The angular step is such that triangles of the grid,
+   * and not only their edges, are within the chordal tolerance.
+   */
+  struct SphereGrid
+  {
+    /// Longitudes and latitudes.
+    std::array<index_t, 2> np;
+    /// Positions and unit normals: 6 floats per point.
+    std::vector<float>     positions_normals;
+  };
+
+  SphereGrid sphere_grid(const Document::AnalyticSphere& sphere,
+                         const TessellationParameters& parameters);
+
+  /**
+   * Points (3 floats each) of a closed polyline along @a circle,
+   * starting and ending at `center + radius * xdir`.
+   * Its chords are within the chordal tolerance.
+   */
+  std::vector<float> circle_points(const Document::AnalyticCircle& circle,
+                                   const TessellationParameters& parameters);
+}
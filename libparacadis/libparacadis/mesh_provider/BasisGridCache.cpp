@@ -0,0 +1,161 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "BasisGridCache.h"
+
+#include <gismo/gismo.h>
+
+#include <exception>
+
+using namespace Mesh;
+
+namespace {
+  /**
+   * Every component of @a basis has knots: grid_hash() tells it apart.
+   */
+  bool has_knots(const gismo::gsTensorBasis<2, real_t>& basis)
+  {
+    try {
+      for(short_t d = 0; d < 2; ++d) {
+        basis.knots(d);
+      }
+      return true;
+    } catch(const std::exception&) {
+      return false;
+    }
+  }
+}
+
+
+BasisGrid BasisGrid::evaluate(const gismo::gsTensorBasis<2, real_t>& basis,
+                              const std::vector<std::vector<real_t>>& samples)
+{
+  BasisGrid result;
+  for(short_t d = 0; d < 2; ++d) {
+    gismo::gsMatrix<real_t> points(1, index_t(samples[d].size()));
+    for(index_t k = 0; k < points.cols(); ++k) {
+      points(0, k) = samples[d][k];
+    }
+    const auto& component = basis.component(d);
+    auto& direction = result.directions[d];
+
+    std::vector<gismo::gsMatrix<real_t>> values_and_derivatives;
+    component.evalAllDers_into(points, 1, values_and_derivatives);
+    component.active_into(points, direction.active);
+    direction.values = std::move(values_and_derivatives[0]);
+    direction.derivatives = std::move(values_and_derivatives[1]);
+    direction.size = basis.size(d);
+    direction.samples = points.cols();
+  }
+  return result;
+}
+
+bool BasisGrid::fits(const gismo::gsTensorBasis<2, real_t>& basis,
+                     const std::vector<std::vector<real_t>>& samples) const
+{
+  const auto& [u, v] = directions;
+  return u.size * v.size == basis.size()
+      && u.size == basis.size(0) && v.size == basis.size(1)
+      && u.samples == index_t(samples[0].size()) && v.samples == index_t(samples[1].size())
+      && u.values.cols() == u.samples && v.values.cols() == v.samples;
+}
+
+size_t BasisGrid::byteSize() const
+{
+  size_t result = sizeof(BasisGrid);
+  for(const auto& direction: directions) {
+    result += sizeof(real_t) * (direction.values.size() + direction.derivatives.size());
+    result += sizeof(index_t) * direction.active.size();
+  }
+  return result;
+}
+
+
+BasisGridCache::BasisGridCache(size_t capacity_bytes)
+    : grids(capacity_bytes)
+{}
+
+BasisGridCache& BasisGridCache::global()
+{
+  static BasisGridCache cache;
+  return cache;
+}
+
+BasisGridCache::grid_t
+BasisGridCache::get(const gismo::gsTensorBasis<2, real_t>& basis,
+                    const std::vector<std::vector<real_t>>& samples)
+{
+  if(!has_knots(basis)) {
+    // grid_hash() would only hash the degrees: not cached.
+    {
+      std::scoped_lock lock{mutex};
+      ++misses;
+    }
+    return std::make_shared<const BasisGrid>(BasisGrid::evaluate(basis, samples));
+  }
+
+  const auto key = grid_hash(basis, samples);
+  {
+    std::scoped_lock lock{mutex};
+    if(const auto* found = grids.find(key)) {
+      if((*found)->fits(basis, samples)) {
+        ++hits;
+        return *found;
+      }
+      ++collisions;
+    }
+    ++misses;
+  }
+
+  // Evaluated without holding the lock.
+  auto grid = std::make_shared<const BasisGrid>(BasisGrid::evaluate(basis, samples));
+  const size_t size = grid->byteSize();
+  std::scoped_lock lock{mutex};
+  grids.insert(key, grid, size);
+  return grid;
+}
+
+void BasisGridCache::setCapacity(size_t capacity_bytes)
+{
+  std::scoped_lock lock{mutex};
+  grids.setCapacity(capacity_bytes);
+}
+
+size_t BasisGridCache::getCapacity() const
+{
+  std::scoped_lock lock{mutex};
+  return grids.getCapacity();
+}
+
+void BasisGridCache::clear()
+{
+  std::scoped_lock lock{mutex};
+  grids.clear();
+}
+
+BasisGridCache::Metrics BasisGridCache::getMetrics() const
+{
+  std::scoped_lock lock{mutex};
+  return {.hits = hits, .misses = misses, .collisions = collisions,
+          .evictions = grids.getEvictions(), .entries = grids.size(),
+          .bytes = grids.getBytes(), .capacity = grids.getCapacity()};
+}
@@ -0,0 +1,143 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "LruIndex.h"
+#include "Tessellation.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Mesh
+{
+  /**
+   * The basis functions of a 2-D tensor basis, evaluated on a tensor grid.
+   *
+   * For each direction, a sparse matrix with one column per sample:
+   * the values (and first derivatives) of the few 1-D basis functions
+   * active at the sample, and their indices.
+   * The value of a 2-D basis function at a grid point is the product
+   * of the two 1-D values. The full matrix is never formed.
+   */
+  struct BasisGrid
+  {
+    struct Direction
+    {
+      gismo::gsMatrix<real_t>  values;
+      gismo::gsMatrix<real_t>  derivatives;
+      gismo::gsMatrix<index_t> active;
+      /// Number of basis functions in this direction.
+      index_t                  size = 0;
+      /// Number of samples (columns of the matrices).
+      index_t                  samples = 0;
+    };
+
+    std::array<Direction, 2> directions;
+
+    /**
+     * Evaluates the components of @a basis at @a samples.
+     */
+    static BasisGrid evaluate(const gismo::gsTensorBasis<2, real_t>& basis,
+                              const std::vector<std::vector<real_t>>& samples);
+
+    /**
+     * It has the sizes of @a basis evaluated at @a samples,
+     * so the cache did not return a grid of another basis with the same hash.
+     */
+    bool fits(const gismo::gsTensorBasis<2, real_t>& basis,
+              const std::vector<std::vector<real_t>>& samples) const;
+
+    size_t byteSize() const;
+  };
+
+  /**
+   * Basis grids shared by every tessellation of the same basis
+   * on the same samples.
+   *
+   * When only the control points (or the weights) of a surface move,
+   * as in most edits, the knots do not change, and neither do the
+   * samples, unless the curvature changes enough to need more of them.
+   * Tessellating again is then only a product of the cached
+   * sparse matrices by the new control points.
+   *
+   * Entries are keyed by grid_hash().
+   * The least recently used ones are dropped when the cache grows
+   * beyond its capacity.
+   * A hit that does not fit the basis (see BasisGrid::fits())
+   * is evaluated again, as a miss, and so are bases without knots,
+   * which grid_hash() cannot tell apart.
+   *
+   * @attention
+   * Two tessellations that miss at the same time both evaluate.
+   */
+  class BasisGridCache
+  {
+  public:
+    using grid_t = std::shared_ptr<const BasisGrid>;
+
+    struct Metrics
+    {
+      std::uint64_t hits = 0;
+      std::uint64_t misses = 0;
+      /// Hits that did not fit: two grids with the same hash.
+      std::uint64_t collisions = 0;
+      std::uint64_t evictions = 0;
+      size_t        entries = 0;
+      size_t        bytes = 0;
+      size_t        capacity = 0;
+    };
+
+    static constexpr size_t default_capacity = 32 * 1024 * 1024;
+
+    explicit BasisGridCache(size_t capacity_bytes = default_capacity);
+
+    /**
+     * The cache used by surface tessellations.
+     */
+    static BasisGridCache& global();
+
+    /**
+     * The grid of @a basis on @a samples: cached, or evaluated and cached.
+     */
+    grid_t get(const gismo::gsTensorBasis<2, real_t>& basis,
+               const std::vector<std::vector<real_t>>& samples);
+
+    void   setCapacity(size_t capacity_bytes);
+    size_t getCapacity() const;
+
+    void clear();
+
+    Metrics getMetrics() const;
+
+  private:
+    mutable std::mutex mutex;
+    /// Protected by `mutex`.
+    LruIndex<std::uint64_t, grid_t> grids;
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t collisions = 0;
+  };
+}
@@ -0,0 +1,160 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "CurveBatch.h"
+
+#include "TessellationCache.h"
+#include "TessellationResult.h"
+
+#include <libparacadis/base/threads/thread_pool/ThreadPool.h>
+
+#include <cassert>
+#include <vector>
+
+using namespace Mesh;
+
+CurveBatch::CurveBatch(const TessellationParameters& parameters)
+    : tessellationParameters(parameters)
+    , mesh(nullptr, parameters, 1)
+{}
+
+void CurveBatch::setCurve(const void* key, std::shared_ptr<const iga_geometry_t> curve,
+                          std::shared_ptr<const Document::AnalyticShape> shape)
+{
+  assert(curve && curve->parDim() == 1 && "Only curves can be batched.");
+  {
+    std::scoped_lock lock{mutex};
+    const bool edited = curves.contains(key);
+    curves[key] = {std::move(curve), std::move(shape), nullptr, edited};
+  }
+  scheduleMerge();
+}
+
+void CurveBatch::removeCurve(const void* key)
+{
+  {
+    std::scoped_lock lock{mutex};
+    if(curves.erase(key) == 0) {
+      return;
+    }
+  }
+  scheduleMerge();
+}
+
+size_t CurveBatch::size() const
+{
+  std::scoped_lock lock{mutex};
+  return curves.size();
+}
+
+void CurveBatch::setTessellationParameters(const TessellationParameters& parameters)
+{
+  {
+    std::scoped_lock lock{mutex};
+    if(tessellationParameters == parameters) {
+      return;
+    }
+    tessellationParameters = parameters;
+    for(auto& [key, curve]: curves) {
+      curve.tessellation = nullptr;
+    }
+  }
+  scheduleMerge();
+}
+
+TessellationParameters CurveBatch::getTessellationParameters() const
+{
+  std::scoped_lock lock{mutex};
+  return tessellationParameters;
+}
+
+void CurveBatch::scheduleMerge()
+{
+  {
+    std::scoped_lock lock{mutex};
+    if(mergeScheduled) {
+      return;
+    }
+    mergeScheduled = true;
+  }
+  Threads::ThreadPool::global().submit([weak_self = weak_from_this()] {
+    auto self = weak_self.lock();
+    if(self) {
+      self->merge();
+    }
+  });
+}
+
+void CurveBatch::merge()
+{
+  std::vector<std::pair<const void*, curve_t>> snapshot;
+  TessellationParameters parameters;
+  Threads::CancellationToken cancel;
+  {
+    std::scoped_lock lock{mutex};
+    mergeScheduled = false;
+    merging.cancel();
+    merging = cancel;
+    parameters = tessellationParameters;
+    snapshot.assign(curves.begin(), curves.end());
+  }
+
+  // Only the curves changed since the last merge.
+  Threads::TaskGroup group;
+  for(auto& [key, curve]: snapshot) {
+    if(curve.tessellation) {
+      continue;
+    }
+    group.run([&, &curve = curve] {
+      if(!cancel.isCancelled()) {
+        curve.tessellation = TessellationCache::global().tessellate(
+            *curve.geometry, parameters, cancel, curve.shape.get(), !curve.edited);
+      }
+    });
+  }
+  group.wait();
+  if(cancel.isCancelled()) {
+    return;
+  }
+
+  std::vector<std::shared_ptr<const TessellationResult>> tessellations;
+  tessellations.reserve(snapshot.size());
+  for(const auto& [key, curve]: snapshot) {
+    tessellations.push_back(curve.tessellation);
+  }
+  auto merged = std::make_shared<const TessellationResult>(merge_curves(tessellations));
+
+  // A newer merge might have started (and finished) meanwhile.
+  std::scoped_lock lock{mutex};
+  if(cancel.isCancelled()) {
+    return;
+  }
+  // Unless the parameters or the curve changed meanwhile.
+  for(const auto& [key, curve]: snapshot) {
+    const auto found = curves.find(key);
+    if(parameters == tessellationParameters && found != curves.end()
+       && found->second.geometry == curve.geometry) {
+      found->second.tessellation = curve.tessellation;
+    }
+  }
+  mesh->showTessellation(std::move(merged));
+}
@@ -0,0 +1,106 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "OgreGismoMesh.h"
+#include "Tessellation.h"
+
+#include <libparacadis/base/expected_behaviour/SharedPtrWrap.h>
+#include <libparacadis/base/threads/thread_pool/TaskGroup.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+namespace Mesh
+{
+  /**
+   * Many curves drawn as a single mesh (a line list).
+   *
+   * Each Ogre::Mesh costs at least one draw call,
+   * and sketches have thousands of edges.
+   * So a ContainerNode puts its curves in a CurveBatch
+   * instead of giving each one a mesh of its own.
+   *
+   * Curves are tessellated (through the TessellationCache)
+   * and merged (see merge_curves()) in the thread pool,
+   * whenever curves are added, changed or removed.
+   * Changes that arrive before the merge starts are merged together.
+   *
+   * Each edit costs a merge of the whole batch:
+   * only the changed curves are tessellated again,
+   * but all of them are copied into the merged chunks (linear in the vertices).
+   * Only the changed blocks of the chunks are uploaded
+   * (see MeshChunk::hash_block_bytes),
+   * although a curve whose vertex count changes shifts the curves after it in its chunk.
+   */
+  class CurveBatch
+      : public std::enable_shared_from_this<CurveBatch>
+  {
+  public:
+    explicit CurveBatch(const TessellationParameters& parameters = {});
+
+    /**
+     * Adds the curve identified by @a key, or replaces its geometry.
+     * @param shape the exact shape of @a curve, if it is a circle.
+     */
+    void setCurve(const void* key, std::shared_ptr<const iga_geometry_t> curve,
+                  std::shared_ptr<const Document::AnalyticShape> shape = {});
+    void removeCurve(const void* key);
+    size_t size() const;
+
+    void setTessellationParameters(const TessellationParameters& parameters);
+    TessellationParameters getTessellationParameters() const;
+
+    void setVisible(bool visible) { mesh->setVisible(visible); }
+    const SharedPtr<Ogre::Mesh>& getOgreMesh() const { return mesh->getOgreMesh(); }
+    /// See OgreGismoMesh::trackEntity().
+    void trackEntity(Ogre::MovableObject* entity) { mesh->trackEntity(entity); }
+
+  private:
+    struct curve_t
+    {
+      std::shared_ptr<const iga_geometry_t>          geometry;
+      std::shared_ptr<const Document::AnalyticShape> shape;
+      /// Null until tessellated with the current parameters.
+      std::shared_ptr<const TessellationResult>      tessellation;
+      /// Its geometry was replaced: it is not kept in the TessellationDiskCache.
+      bool                                           edited = false;
+    };
+
+    mutable std::mutex mutex;
+    std::map<const void*, curve_t> curves;
+    TessellationParameters tessellationParameters;
+
+    /// A merge was submitted and has not started yet. Protected by `mutex`.
+    bool mergeScheduled = false;
+    /// Cancels the ongoing merge when a newer one starts. Protected by `mutex`.
+    Threads::CancellationToken merging;
+
+    /// No geometry of its own: it shows the merged tessellations.
+    SharedPtrWrap<OgreGismoMesh> mesh;
+
+    void scheduleMerge();
+    void merge();
+  };
+}
@@ -0,0 +1,662 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "DocumentExporter.h"
+
+#include "TessellationResult.h"
+
+#include <libparacadis/base/exceptions.h>
+#include <libparacadis/base/expected_behaviour/CycleGuard.h>
+#include <libparacadis/base/geometric_primitives/DocumentGeometry.h>
+#include <libparacadis/base/geometric_primitives/types.h>
+#include <libparacadis/base/threads/thread_pool/TaskGroup.h>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+using namespace Mesh;
+
+namespace {
+  /**
+   * Rotation (3x3, row major) followed by a translation.
+   */
+  struct transform_t
+  {
+    std::array<double, 9> rotation{1, 0, 0,
+                                   0, 1, 0,
+                                   0, 0, 1};
+    std::array<double, 3> translation{0, 0, 0};
+
+    void applyToPoint(float* p) const
+    {
+      const double x = p[0], y = p[1], z = p[2];
+      for(int i = 0; i < 3; ++i) {
+        p[i] = float(rotation[3*i] * x + rotation[3*i+1] * y + rotation[3*i+2] * z
+                     + translation[i]);
+      }
+    }
+
+    void applyToVector(float* v) const
+    {
+      const double x = v[0], y = v[1], z = v[2];
+      for(int i = 0; i < 3; ++i) {
+        v[i] = float(rotation[3*i] * x + rotation[3*i+1] * y + rotation[3*i+2] * z);
+      }
+    }
+  };
+
+  /**
+   * Placement of @a container in its parent: the columns of the rotation
+   * are its axes, and the translation is its origin.
+   */
+  transform_t placement(const Document::Container& container)
+  {
+    transform_t result;
+    auto coordinates = container.getCoordinates();
+    if(!coordinates) {
+      return result;
+    }
+    const auto cs = coordinates->getCoordinateSystem();
+    const std::array<const Vector*, 3> axes{&cs.x_axis(), &cs.y_axis(), &cs.z_axis()};
+    for(int j = 0; j < 3; ++j) {
+      result.rotation[j]   = types::to_float(axes[j]->x());
+      result.rotation[3+j] = types::to_float(axes[j]->y());
+      result.rotation[6+j] = types::to_float(axes[j]->z());
+    }
+    result.translation = {types::to_float(cs.origin().x()),
+                          types::to_float(cs.origin().y()),
+                          types::to_float(cs.origin().z())};
+    return result;
+  }
+
+  /**
+   * First @a inner, then @a outer.
+   */
+  transform_t compose(const transform_t& outer, const transform_t& inner)
+  {
+    transform_t result;
+    for(int i = 0; i < 3; ++i) {
+      for(int j = 0; j < 3; ++j) {
+        result.rotation[3*i+j] = outer.rotation[3*i]   * inner.rotation[j]
+                               + outer.rotation[3*i+1] * inner.rotation[3+j]
+                               + outer.rotation[3*i+2] * inner.rotation[6+j];
+      }
+      result.translation[i] = outer.rotation[3*i]   * inner.translation[0]
+                            + outer.rotation[3*i+1] * inner.translation[1]
+                            + outer.rotation[3*i+2] * inner.translation[2]
+                            + outer.translation[i];
+    }
+    return result;
+  }
+
+  struct item_t
+  {
+    SharedPtr<Document::DocumentGeometry> geometry;
+    transform_t                           transform;
+  };
+
+  /**
+   * Geometries of @a container and of its sub-containers, depth first.
+   */
+  void collect(CycleGuard<const Document::Container>& cycle_guard,
+               const Document::Container& container,
+               const transform_t& transform, std::vector<item_t>& items)
+  {
+    auto cycle_sentinel = cycle_guard.sentinel(&container);
+    if(!cycle_sentinel.success()) {
+      return;
+    }
+
+    { // Locked scope.
+      auto view_lock = container.nonContainersView();
+      for(auto& [k, leaf]: view_lock) {
+        auto geometry = leaf.cast_nothrow<Document::DocumentGeometry>();
+        if(geometry) {
+          items.push_back({std::move(geometry), transform});
+        }
+      }
+    }
+
+    std::vector<SharedPtr<Document::Container>> children;
+    { // Locked scope.
+      auto view_lock = container.containersView();
+      children.reserve(view_lock.size());
+      for(auto& [k, child]: view_lock) {
+        children.push_back(child);
+      }
+    }
+    for(const auto& child: children) {
+      collect(cycle_guard, *child, compose(transform, placement(*child)), items);
+    }
+  }
+
+  /**
+   * The tessellation of @a item, placed in the world.
+   */
+  TessellationResult tessellate_item(const item_t& item,
+                                     const TessellationParameters& parameters)
+  {
+    auto iga_geometry = item.geometry->getIgaGeometry();
+    if(!iga_geometry) {
+      return {};
+    }
+    const auto shape = item.geometry->getAnalyticShape();
+    auto result = tessellate(*iga_geometry, parameters, {}, shape ? &*shape : nullptr);
+    const size_t entries = result.entriesPerPoint();
+    for(auto& chunk: result.chunks) {
+      for(size_t k = 0; k < chunk.vertex.size(); k += entries) {
+        item.transform.applyToPoint(&chunk.vertex[k]);
+        if(entries == 6) {
+          item.transform.applyToVector(&chunk.vertex[k+3]);
+        }
+      }
+    }
+    return result;
+  }
+
+  /**
+   * Appends @a value to @a buffer, in little endian.
+   */
+  template<typename T>
+  void put(std::string& buffer, T value)
+  {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    if constexpr(std::endian::native == std::endian::big) {
+      std::reverse(bytes, bytes + sizeof(T));
+    }
+    buffer.append(bytes, sizeof(T));
+  }
+
+  /**
+   * Writes tessellations to a stream in one file format.
+   *
+   * Each geometry is formatted in a buffer, and then written at once.
+   */
+  class FileWriter
+  {
+  public:
+    explicit FileWriter(std::ostream& out) : out(out) {}
+    virtual ~FileWriter() = default;
+
+    virtual void begin() = 0;
+    /**
+     * @returns False if the format cannot represent @a result.
+     */
+    virtual bool write(const TessellationResult& result, size_t index) = 0;
+    virtual void finish() = 0;
+
+    size_t getBytes() const { return bytes; }
+
+  protected:
+    std::ostream& out;
+    std::string   buffer;
+    size_t        bytes = 0;
+
+    void flush()
+    {
+      out.write(buffer.data(), buffer.size());
+      if(!out) {
+        throw Exception::RunTimeError("Could not write the exported mesh.");
+      }
+      bytes += buffer.size();
+      buffer.clear();
+    }
+
+    /**
+     * Writes @a text at @a position, and goes back to the end.
+     */
+    void overwrite(std::streampos position, const std::string& text)
+    {
+      const auto end = out.tellp();
+      out.seekp(position);
+      out.write(text.data(), text.size());
+      out.seekp(end);
+      if(!out) {
+        throw Exception::RunTimeError("Could not write the exported mesh header.");
+      }
+    }
+
+    std::streampos seekablePosition()
+    {
+      const auto position = out.tellp();
+      if(position == std::streampos(-1)) {
+        throw Exception::RunTimeError("This format needs a seekable stream.");
+      }
+      return position;
+    }
+  };
+
+  class StlWriter : public FileWriter
+  {
+  public:
+    using FileWriter::FileWriter;
+
+    void begin() override
+    {
+      buffer.assign(80, '\0');
+      const std::string_view title = "ParaCADis binary STL";
+      std::copy(title.begin(), title.end(), buffer.begin());
+      countPosition = seekablePosition() + std::streamoff(80);
+      put<std::uint32_t>(buffer, 0);
+      flush();
+    }
+
+    bool write(const TessellationResult& result, size_t) override
+    {
+      if(result.dimension != 2) {
+        return false;
+      }
+      for(const auto& chunk: result.chunks) {
+        if(chunk.isWide()) {
+          writeTriangles(chunk, chunk.wideIndexes);
+        } else {
+          writeTriangles(chunk, chunk.indexes);
+        }
+      }
+      flush();
+      return true;
+    }
+
+    void finish() override
+    {
+      std::string count;
+      put<std::uint32_t>(count, std::uint32_t(triangles));
+      overwrite(countPosition, count);
+    }
+
+  private:
+    std::streampos countPosition;
+    size_t         triangles = 0;
+
+    template<typename Index>
+    void writeTriangles(const MeshChunk& chunk, const std::vector<Index>& indexes)
+    {
+      constexpr size_t entries = 6;
+      for(size_t k = 0; k + 2 < indexes.size(); k += 3) {
+        const float* a = &chunk.vertex[entries * indexes[k]];
+        const float* b = &chunk.vertex[entries * indexes[k+1]];
+        const float* c = &chunk.vertex[entries * indexes[k+2]];
+
+        // The facet normal, from the vertices (counter-clockwise).
+        const float u[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+        const float v[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+        float n[3] = {u[1] * v[2] - u[2] * v[1],
+                      u[2] * v[0] - u[0] * v[2],
+                      u[0] * v[1] - u[1] * v[0]};
+        const float length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        for(auto& x: n) {
+          x = (length > 0) ? x / length : 0;
+        }
+
+        for(const float* p: {(const float*)n, a, b, c}) {
+          put(buffer, p[0]);
+          put(buffer, p[1]);
+          put(buffer, p[2]);
+        }
+        put<std::uint16_t>(buffer, 0);
+        ++triangles;
+      }
+    }
+  };
+
+  /**
+   * Vertices are written as they come, but PLY wants every face after
+   * every vertex. So faces go to a temporary file,
+   * appended when everything is written.
+   */
+  class PlyWriter : public FileWriter
+  {
+  public:
+    using FileWriter::FileWriter;
+
+    void begin() override
+    {
+      faces.reset(std::tmpfile());
+      if(!faces) {
+        throw Exception::RunTimeError("Could not create a temporary file for the faces.");
+      }
+
+      buffer = "ply\n"
+               "format binary_little_endian 1.0\n"
+               "comment ParaCADis\n";
+      vertexCountPosition = seekablePosition()
+                            + std::streamoff(buffer.size() + vertex_element.size());
+      buffer += vertex_element + count(0) + "\n";
+      buffer += "property float x\n"
+                "property float y\n"
+                "property float z\n"
+                "property float nx\n"
+                "property float ny\n"
+                "property float nz\n";
+      faceCountPosition = seekablePosition()
+                          + std::streamoff(buffer.size() + face_element.size());
+      buffer += face_element + count(0) + "\n";
+      buffer += "property list uchar uint vertex_indices\n"
+                "end_header\n";
+      flush();
+    }
+
+    bool write(const TessellationResult& result, size_t) override
+    {
+      if(result.dimension != 2) {
+        return false;
+      }
+      std::string face_buffer;
+      for(const auto& chunk: result.chunks) {
+        buffer.append(reinterpret_cast<const char*>(chunk.vertex.data()),
+                      sizeof(float) * chunk.vertex.size());
+        if(chunk.isWide()) {
+          writeFaces(face_buffer, chunk.wideIndexes);
+        } else {
+          writeFaces(face_buffer, chunk.indexes);
+        }
+        vertices += chunk.vertex.size() / 6;
+      }
+      if constexpr(std::endian::native == std::endian::big) {
+        for(size_t k = 0; k < buffer.size(); k += sizeof(float)) {
+          std::reverse(buffer.data() + k, buffer.data() + k + sizeof(float));
+        }
+      }
+      flush();
+
+      if(std::fwrite(face_buffer.data(), 1, face_buffer.size(), faces.get()) != face_buffer.size()) {
+        throw Exception::RunTimeError("Could not write the faces to a temporary file.");
+      }
+      return true;
+    }
+
+    void finish() override
+    {
+      std::rewind(faces.get());
+      buffer.resize(1 << 20);
+      size_t read = 0;
+      while((read = std::fread(buffer.data(), 1, buffer.size(), faces.get())) > 0) {
+        buffer.resize(read);
+        flush();
+        buffer.resize(1 << 20);
+      }
+      buffer.clear();
+      faces.reset();
+
+      overwrite(vertexCountPosition, count(vertices));
+      overwrite(faceCountPosition, count(triangles));
+    }
+
+  private:
+    /// Room for the counts, which are only known at the end.
+    static constexpr int count_width = 10;
+    inline static const std::string vertex_element = "element vertex ";
+    inline static const std::string face_element = "element face ";
+
+    struct file_closer_t { void operator()(std::FILE* f) const { std::fclose(f); } };
+    std::unique_ptr<std::FILE, file_closer_t> faces;
+
+    std::streampos vertexCountPosition;
+    std::streampos faceCountPosition;
+    size_t vertices = 0;
+    size_t triangles = 0;
+
+    static std::string count(size_t n)
+    {
+      return std::format("{:<{}}", n, count_width);
+    }
+
+    template<typename Index>
+    void writeFaces(std::string& face_buffer, const std::vector<Index>& indexes)
+    {
+      for(size_t k = 0; k + 2 < indexes.size(); k += 3) {
+        put<std::uint8_t>(face_buffer, 3);
+        put<std::uint32_t>(face_buffer, std::uint32_t(vertices + indexes[k]));
+        put<std::uint32_t>(face_buffer, std::uint32_t(vertices + indexes[k+1]));
+        put<std::uint32_t>(face_buffer, std::uint32_t(vertices + indexes[k+2]));
+        ++triangles;
+      }
+    }
+  };
+
+  class ObjWriter : public FileWriter
+  {
+  public:
+    using FileWriter::FileWriter;
+
+    void begin() override
+    {
+      buffer = "# ParaCADis\n";
+      flush();
+    }
+
+    bool write(const TessellationResult& result, size_t index) override
+    {
+      if(result.dimension != 1 && result.dimension != 2) {
+        return false;
+      }
+      std::format_to(std::back_inserter(buffer), "o geometry_{}\n", index);
+      const size_t entries = result.entriesPerPoint();
+      for(const auto& chunk: result.chunks) {
+        for(size_t k = 0; k < chunk.vertex.size(); k += entries) {
+          const float* p = &chunk.vertex[k];
+          std::format_to(std::back_inserter(buffer), "v {} {} {}\n", p[0], p[1], p[2]);
+        }
+        if(entries == 6) {
+          for(size_t k = 0; k < chunk.vertex.size(); k += entries) {
+            const float* n = &chunk.vertex[k+3];
+            std::format_to(std::back_inserter(buffer), "vn {} {} {}\n", n[0], n[1], n[2]);
+          }
+        }
+
+        if(chunk.isWide()) {
+          writeElements(result.dimension, chunk.wideIndexes);
+        } else {
+          writeElements(result.dimension, chunk.indexes);
+        }
+
+        const size_t count = chunk.vertex.size() / entries;
+        vertices += count;
+        if(entries == 6) {
+          normals += count;
+        }
+      }
+      flush();
+      return true;
+    }
+
+    void finish() override {}
+
+  private:
+    /// Written so far: OBJ indexes are global (and start at 1).
+    /// @{
+    size_t vertices = 0;
+    size_t normals = 0;
+    /// @}
+
+    template<typename Index>
+    void writeElements(short_t dimension, const std::vector<Index>& indexes)
+    {
+      auto out = std::back_inserter(buffer);
+      if(dimension == 1) {
+        // A line strip.
+        buffer += "l";
+        for(auto i: indexes) {
+          std::format_to(out, " {}", vertices + i + 1);
+        }
+        buffer += "\n";
+        return;
+      }
+      for(size_t k = 0; k + 2 < indexes.size(); k += 3) {
+        std::format_to(out, "f {}//{} {}//{} {}//{}\n",
+                       vertices + indexes[k] + 1,   normals + indexes[k] + 1,
+                       vertices + indexes[k+1] + 1, normals + indexes[k+1] + 1,
+                       vertices + indexes[k+2] + 1, normals + indexes[k+2] + 1);
+      }
+    }
+  };
+
+  std::unique_ptr<FileWriter> make_writer(ExportFormat format, std::ostream& out)
+  {
+    switch(format) {
+    case ExportFormat::STL:
+      return std::make_unique<StlWriter>(out);
+    case ExportFormat::PLY:
+      return std::make_unique<PlyWriter>(out);
+    case ExportFormat::OBJ:
+      return std::make_unique<ObjWriter>(out);
+    }
+    throw Exception::NotImplemented{};
+  }
+}
+
+
+double DocumentExporter::Metrics::megabytesPerSecond() const
+{
+  return (elapsed.count() > 0) ? bytes / (1024.0 * 1024.0) / elapsed.count() : 0;
+}
+
+double DocumentExporter::Metrics::trianglesPerSecond() const
+{
+  return (elapsed.count() > 0) ? triangles / elapsed.count() : 0;
+}
+
+
+DocumentExporter::DocumentExporter(ExportFormat format,
+                                   const TessellationParameters& parameters)
+    : format(format)
+    , parameters(parameters)
+{
+  // Whole meshes, in floats: they are not uploaded to a GPU.
+  this->parameters.wideIndexes = true;
+  this->parameters.vertexFormat = VertexFormat::FLOAT;
+}
+
+void DocumentExporter::setWindow(size_t geometries)
+{
+  window = std::max<size_t>(1, geometries);
+}
+
+DocumentExporter::Metrics
+DocumentExporter::exportDocument(const Document::Container& root,
+                                 const std::filesystem::path& path) const
+{
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  if(!out) {
+    throw Exception::RunTimeError(std::format("Could not open '{}' for writing.",
+                                              path.string()));
+  }
+  return exportDocument(root, out);
+}
+
+DocumentExporter::Metrics
+DocumentExporter::exportDocument(const Document::Container& root, std::ostream& out) const
+{
+  const auto start = std::chrono::steady_clock::now();
+
+  std::vector<item_t> items;
+  CycleGuard<const Document::Container> cycle_guard;
+  collect(cycle_guard, root, transform_t{}, items);
+
+  auto writer = make_writer(format, out);
+  writer->begin();
+
+  /*
+   * A ring of `window` slots: the tessellation of item `k` goes to slot
+   * `k % window`, and it is only submitted after item `k - window`
+   * was written.
+   */
+  struct slot_t
+  {
+    std::optional<TessellationResult> result;
+    std::exception_ptr                error;
+  };
+  std::vector<slot_t>     slots(std::min(window, std::max<size_t>(1, items.size())));
+  std::mutex              mutex;
+  std::condition_variable ready;
+
+  Metrics metrics;
+  Threads::TaskGroup group;
+  size_t next = 0;
+  auto write_next = [&] {
+    slot_t slot;
+    {
+      std::unique_lock lock{mutex};
+      auto& ring_slot = slots[next % slots.size()];
+      ready.wait(lock, [&]{ return ring_slot.result || ring_slot.error; });
+      std::swap(slot, ring_slot);
+    }
+    if(slot.error) {
+      group.cancel();
+      std::rethrow_exception(slot.error);
+    }
+
+    const auto& result = *slot.result;
+    if(writer->write(result, next)) {
+      ++metrics.geometries;
+      metrics.vertices += result.vertexCount();
+      metrics.triangles += result.triangleCount();
+      if(result.dimension == 1) {
+        for(const auto& chunk: result.chunks) {
+          metrics.segments += std::max<size_t>(chunk.indexCount(), 1) - 1;
+        }
+      }
+    } else {
+      ++metrics.skipped;
+    }
+    ++next;
+  };
+
+  for(size_t k = 0; k < items.size(); ++k) {
+    if(k >= slots.size()) {
+      write_next();
+    }
+    group.run([&, k] {
+      slot_t slot;
+      try {
+        slot.result = tessellate_item(items[k], parameters);
+      } catch(...) {
+        slot.error = std::current_exception();
+      }
+      std::scoped_lock lock{mutex};
+      slots[k % slots.size()] = std::move(slot);
+      ready.notify_all();
+    });
+  }
+  while(next < items.size()) {
+    write_next();
+  }
+
+  writer->finish();
+  metrics.bytes = writer->getBytes();
+  metrics.elapsed = std::chrono::steady_clock::now() - start;
+  return metrics;
+}
@@ -0,0 +1,116 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "Tessellation.h"
+
+#include <libparacadis/base/document_tree/Container.h>
+
+#include <chrono>
+#include <filesystem>
+#include <ostream>
+
+namespace Mesh
+{
+  /**
+   * File formats a document can be exported to.
+   */
+  enum class ExportFormat {
+    /// Binary STL: triangles only, curves are skipped.
+    STL,
+    /// Binary (little endian) PLY with normals: triangles only, curves are skipped.
+    PLY,
+    /// Wavefront OBJ (text): surfaces with normals, and curves as lines.
+    OBJ,
+  };
+
+  /**
+   * Writes the tessellation of every geometry of a document to a mesh file,
+   * for downstream tools (slicers, simulation, other CAD programs).
+   *
+   * Geometries are placed by the coordinate systems of the containers
+   * they are in, like in the scene. The root container is the world.
+   * A geometry that is in many containers is written many times.
+   *
+   * Geometries are tessellated in the Threads::ThreadPool,
+   * and written in the order they are found in the document.
+   * At most `window` of them are tessellated ahead of the one
+   * being written, so the memory used does not depend
+   * on the size of the document.
+   *
+   * @attention
+   * Do not call it from a task of the ThreadPool:
+   * it blocks waiting for the tessellations.
+   */
+  class DocumentExporter
+  {
+  public:
+    /// Geometries tessellated ahead of the one being written.
+    static constexpr size_t default_window = 64;
+
+    struct Metrics
+    {
+      /// Written, and skipped because the format cannot represent them.
+      /// @{
+      size_t geometries = 0;
+      size_t skipped = 0;
+      /// @}
+      size_t vertices = 0;
+      size_t triangles = 0;
+      /// Line segments of the curves.
+      size_t segments = 0;
+      size_t bytes = 0;
+      std::chrono::duration<double> elapsed{0};
+
+      double megabytesPerSecond() const;
+      double trianglesPerSecond() const;
+    };
+
+    explicit DocumentExporter(ExportFormat format,
+                              const TessellationParameters& parameters = {});
+
+    void   setWindow(size_t geometries);
+    size_t getWindow() const { return window; }
+
+    /**
+     * Exports every geometry in @a root and in its sub-containers.
+     *
+     * STL and PLY need to go back to the header when everything is written,
+     * so @a out must be seekable (a file, or a string stream).
+     * PLY also needs a temporary file for the faces.
+     *
+     * @throws Exception::RunTimeError if the stream cannot be written
+     * (or the geometries cannot be tessellated).
+     */
+    /// @{
+    Metrics exportDocument(const Document::Container& root, std::ostream& out) const;
+    Metrics exportDocument(const Document::Container& root,
+                           const std::filesystem::path& path) const;
+    /// @}
+
+  private:
+    ExportFormat           format;
+    TessellationParameters parameters;
+    size_t                 window = default_window;
+  };
+}
@@ -22,12 +22,55 @@
 
 #include "GlThreadQueue.h"
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
 
 namespace Mesh
 {
+  namespace {
+    template<typename F>
+    void run_catching(F&& f)
+    {
+      try {
+        f();
+      } catch(const std::exception& e) {
+        std::cerr << "Exception caught in rednering queue: " << e.what() << ".\n";
+      } catch(...) {
+        std::cerr << "Unkown exception caught in rendering queue.\n";
+      }
+    }
+  }
+
   bool GlThreadQueue::frameStarted(const Ogre::FrameEvent& /*evt*/)
+  {
+    runCallbacks();
+    collectUploads();
+    runUploads();
+    return true;
+  }
+
+  void GlThreadQueue::push(std::function<void()> callback)
+  {
+    queue.push(std::move(callback));
+  }
+
+  void GlThreadQueue::pushUpload(UploadRequest request)
+  {
+    ++incoming;
+    uploadQueue.push(std::move(request));
+  }
+
+  GlThreadQueue::Metrics GlThreadQueue::getMetrics() const
+  {
+    return {.queueDepth     = queueDepth + incoming,
+            .bytesLastFrame = bytesLastFrame,
+            .bytesUploaded  = bytesUploaded,
+            .uploads        = uploads,
+            .dropped        = dropped};
+  }
+
+  void GlThreadQueue::runCallbacks()
   {
     // I know... queue.empty() is not thread safe.
     // But we have no problems with spurious fail.
@@ -37,14 +80,72 @@ namespace Mesh
       if(!callback) {
         break;
       }
-      try {
-        (*callback)();
-      } catch(const std::exception& e) {
-        std::cerr << "Exception caught in rednering queue: " << e.what() << ".\n";
-      } catch(...) {
-        std::cerr << "Unkown exception caught in rendering queue.\n";
+      run_catching(*callback);
+    }
+  }
+
+  void GlThreadQueue::collectUploads()
+  {
+    while(auto request = uploadQueue.try_pull()) {
+      --incoming;
+      auto key = request->key;
+      auto it = pendingIndex.find(key);
+      if(key == nullptr || it == pendingIndex.end()) {
+        if(key) {
+          pendingIndex.emplace(key, pending.size());
+        }
+        pending.push_back({std::move(*request), sequence++});
+        continue;
       }
+
+      // Superseded: the newest upload replaces the older one,
+      // but keeps its place in line and the most urgent priority.
+      auto& old = pending[it->second].request;
+      request->priority = std::min(request->priority, old.priority);
+      old = std::move(*request);
+      ++dropped;
     }
-    return true;
+    queueDepth = pending.size();
+  }
+
+  void GlThreadQueue::runUploads()
+  {
+    if(pending.empty()) {
+      bytesLastFrame = 0;
+      return;
+    }
+
+    std::ranges::sort(pending, [](const pending_t& a, const pending_t& b) {
+      if(a.request.priority != b.request.priority) {
+        return a.request.priority < b.request.priority;
+      }
+      return a.sequence < b.sequence;
+    });
+
+    // At least one upload per frame, so big meshes are not stuck forever.
+    const size_t budget = bytesPerFrame;
+    size_t bytes = 0;
+    size_t done  = 0;
+    for(auto& p: pending) {
+      if(done > 0 && bytes + p.request.bytes > budget) {
+        break;
+      }
+      run_catching(p.request.upload);
+      bytes += p.request.bytes;
+      ++done;
+    }
+    pending.erase(pending.begin(), pending.begin() + done);
+
+    pendingIndex.clear();
+    for(size_t i = 0; i < pending.size(); ++i) {
+      if(pending[i].request.key) {
+        pendingIndex.emplace(pending[i].request.key, i);
+      }
+    }
+
+    bytesLastFrame = bytes;
+    bytesUploaded += bytes;
+    uploads += done;
+    queueDepth = pending.size();
   }
 }
@@ -25,15 +25,51 @@
 #include <libparacadis/base/threads/safe_structs/ThreadSafeQueue.h>
 #include <OGRE/OgreFrameListener.h>
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
+#include <unordered_map>
+#include <vector>
 
 namespace Mesh
 {
+  /**
+   * Which uploads go first. Lower values go first.
+   */
+  enum class UploadPriority {
+    /// The mesh was just edited: the user is looking at it.
+    EDITED,
+    /// The mesh is in the scene.
+    VISIBLE,
+    /// Everything else.
+    HIDDEN,
+  };
+
+  /**
+   * A GPU upload to be executed in the GL thread.
+   */
+  struct UploadRequest
+  {
+    /// Identifies what is being uploaded (the mesh).
+    /// A newer request with the same key supersedes the older one.
+    const void*           key = nullptr;
+    UploadPriority        priority = UploadPriority::HIDDEN;
+    /// Approximate number of bytes sent to the GPU.
+    size_t                bytes = 0;
+    std::function<void()> upload;
+  };
+
   /**
    * GL operations can only be made in the thread that holds the GL context.
    * Therefore, we register this frame listener that holds a queue of
    * closures (lambdas) that will be executed in this thread.
    *
+   * Uploads are not simply executed in arrival order.
+   * When a document is loaded, thousands of meshes would be uploaded
+   * in a single frame. Instead, they are scheduled by UploadPriority
+   * and limited by a bytes-per-frame budget. An upload that is superseded
+   * by a newer one for the same mesh, before it is executed, is dropped.
+   *
    * @attention
    * Ideally, only the GL part should be executed by those lambdas.
    */
@@ -41,7 +77,63 @@ namespace Mesh
       : public Ogre::FrameListener
   {
   public:
+    struct Metrics
+    {
+      /// Uploads waiting to be executed.
+      size_t        queueDepth = 0;
+      size_t        bytesLastFrame = 0;
+      std::uint64_t bytesUploaded = 0;
+      std::uint64_t uploads = 0;
+      /// Uploads superseded before being executed.
+      std::uint64_t dropped = 0;
+    };
+
     bool frameStarted(const Ogre::FrameEvent& evt) override;
+
+    /**
+     * Queues a GL operation that is not subject to the upload budget.
+     */
+    void push(std::function<void()> callback);
+
+    /**
+     * Queues an upload to be scheduled.
+     */
+    void pushUpload(UploadRequest request);
+
+    void setBytesPerFrame(size_t bytes) { bytesPerFrame = bytes; }
+    size_t getBytesPerFrame() const { return bytesPerFrame; }
+
+    Metrics getMetrics() const;
+
+  private:
     Threads::SafeStructs::ThreadSafeQueue<std::function<void()>> queue;
+    Threads::SafeStructs::ThreadSafeQueue<UploadRequest>         uploadQueue;
+
+    std::atomic<size_t> bytesPerFrame = 16 * 1024 * 1024;
+
+    /**
+     * Only accessed by the GL thread.
+     */
+    /// @{
+    struct pending_t
+    {
+      UploadRequest request;
+      std::uint64_t sequence;
+    };
+    std::vector<pending_t>                 pending;
+    std::unordered_map<const void*, size_t> pendingIndex;
+    std::uint64_t                          sequence = 0;
+    /// @}
+
+    std::atomic<size_t>        incoming{0};
+    std::atomic<size_t>        queueDepth{0};
+    std::atomic<size_t>        bytesLastFrame{0};
+    std::atomic<std::uint64_t> bytesUploaded{0};
+    std::atomic<std::uint64_t> uploads{0};
+    std::atomic<std::uint64_t> dropped{0};
+
+    void runCallbacks();
+    void collectUploads();
+    void runUploads();
   };
 }
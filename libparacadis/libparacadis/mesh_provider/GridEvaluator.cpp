@@ -0,0 +1,208 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "GridEvaluator.h"
+#include "VertexPacking.h"
+
+#include <gismo/gismo.h>
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+
+using namespace Mesh;
+
+namespace {
+  /**
+   * The normal is zero when \f$|S_u \times S_v|\f$ is below this
+   * fraction of \f$\max(|S_u|, |S_v|)^2\f$.
+   * At a pole, one derivative vanishes up to rounding errors,
+   * and their cross product would be noise.
+   */
+  constexpr real_t degenerate = 1e-10;
+
+  using vector3_t = std::array<real_t, 3>;
+
+  real_t dot(const vector3_t& a, const vector3_t& b)
+  {
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+  }
+
+  /**
+   * Writes \f$S_u \times S_v\f$ (not normalized) to @a out,
+   * or zero where the surface is degenerate.
+   */
+  void write_normal(const vector3_t& du, const vector3_t& dv, real_t* out)
+  {
+    const vector3_t normal{du[1] * dv[2] - du[2] * dv[1],
+                           du[2] * dv[0] - du[0] * dv[2],
+                           du[0] * dv[1] - du[1] * dv[0]};
+    const real_t length = std::sqrt(dot(normal, normal));
+    const real_t scale2 = std::max(dot(du, du), dot(dv, dv));
+    const bool regular = (length > degenerate * scale2);
+    for(int d = 0; d < 3; ++d) {
+      out[d] = regular ? normal[d] : 0;
+    }
+  }
+
+  /**
+   * A tensor basis, looking through the weights of a rational one.
+   */
+  const gismo::gsTensorBasis<2, real_t>* tensor_basis(const gismo::gsBasis<real_t>& basis)
+  {
+    const auto& source = basis.isRational() ? basis.source() : basis;
+    return dynamic_cast<const gismo::gsTensorBasis<2, real_t>*>(&source);
+  }
+}
+
+
+GridEvaluator::GridEvaluator(const iga_geometry_t& _surface,
+                             std::vector<std::vector<real_t>> _samples,
+                             BasisGridCache& cache)
+    : surface(_surface)
+    , samples(std::move(_samples))
+{
+  assert(surface.parDim() == 2 && "Must be a surface.");
+  assert(samples.size() == 2 && "Samples along both directions.");
+
+  const auto& basis = surface.basis();
+  const auto* tensor_product = tensor_basis(basis);
+  const auto& coefs = surface.coefs();
+  const index_t target_dim = surface.targetDim();
+  if(!tensor_product || coefs.rows() != tensor_product->size() || target_dim > 3) {
+    return;
+  }
+
+  grid = cache.get(*tensor_product, samples);
+
+  homogeneous.resize(4 * coefs.rows());
+  for(index_t k = 0; k < coefs.rows(); ++k) {
+    const real_t weight = basis.isRational() ? basis.weights()(k, 0) : real_t(1);
+    for(index_t d = 0; d < 3; ++d) {
+      homogeneous[4 * k + d] = (d < target_dim) ? weight * coefs(k, d) : 0;
+    }
+    homogeneous[4 * k + 3] = weight;
+  }
+}
+
+
+void GridEvaluator::evaluate(index_t first_row, index_t row_count, float* out) const
+{
+  assert(first_row >= 0 && first_row + row_count <= rows());
+  if(grid) {
+    evaluateTensor(first_row, row_count, out);
+  } else {
+    evaluateGeneric(first_row, row_count, out);
+  }
+}
+
+
+void GridEvaluator::evaluateTensor(index_t first_row, index_t row_count, float* out) const
+{
+  const auto& [values_u, derivatives_u, active_u, size_u, samples_u] = grid->directions[0];
+  const auto& [values_v, derivatives_v, active_v, size_v, samples_v] = grid->directions[1];
+
+  /*
+   * The row of coefficients contracted along `v`:
+   * by the basis functions, and by their derivatives.
+   * Four values (a homogeneous coefficient) per function along `u`.
+   */
+  std::vector<real_t> row(4 * size_u);
+  std::vector<real_t> row_v(4 * size_u);
+  // Evaluated in double precision, and then packed.
+  std::vector<real_t> positions(3 * cols());
+  std::vector<real_t> normals(3 * cols());
+
+  for(index_t j = first_row; j < first_row + row_count; ++j) {
+    std::ranges::fill(row, 0);
+    std::ranges::fill(row_v, 0);
+    for(index_t b = 0; b < active_v.rows(); ++b) {
+      const real_t value = values_v(b, j);
+      const real_t derivative = derivatives_v(b, j);
+      // A whole row of coefficients is contiguous: the loop vectorizes.
+      const real_t* coef = homogeneous.data() + 4 * active_v(b, j) * size_u;
+      for(index_t n = 0; n < 4 * size_u; ++n) {
+        row[n]   += value * coef[n];
+        row_v[n] += derivative * coef[n];
+      }
+    }
+
+    for(index_t i = 0; i < cols(); ++i) {
+      // Homogeneous position and derivatives.
+      std::array<real_t, 4> p{}, pu{}, pv{};
+      for(index_t a = 0; a < active_u.rows(); ++a) {
+        const real_t value = values_u(a, i);
+        const real_t derivative = derivatives_u(a, i);
+        const real_t* coef = &row[4 * active_u(a, i)];
+        const real_t* coef_v = &row_v[4 * active_u(a, i)];
+        for(int d = 0; d < 4; ++d) {
+          p[d]  += value * coef[d];
+          pu[d] += derivative * coef[d];
+          pv[d] += value * coef_v[d];
+        }
+      }
+
+      // Quotient rule: \f$S' = (P' - S w') / w\f$.
+      const real_t inverse = 1 / p[3];
+      real_t* position = &positions[3 * i];
+      vector3_t du, dv;
+      for(int d = 0; d < 3; ++d) {
+        position[d] = p[d] * inverse;
+        du[d] = (pu[d] - position[d] * pu[3]) * inverse;
+        dv[d] = (pv[d] - position[d] * pv[3]) * inverse;
+      }
+      write_normal(du, dv, &normals[3 * i]);
+    }
+    pack_vertices(positions.data(), normals.data(), cols(), out);
+    out += entries * cols();
+  }
+}
+
+
+void GridEvaluator::evaluateGeneric(index_t first_row, index_t row_count, float* out) const
+{
+  const std::vector<real_t> rows_v(samples[1].begin() + first_row,
+                                   samples[1].begin() + first_row + row_count);
+  const auto points = grid_points({samples[0], rows_v});
+
+  gismo::gsFuncData<real_t> data(gismo::NEED_VALUE | gismo::NEED_DERIV);
+  surface.compute(points, data);
+  const auto& positions = data.values[0];
+  // For each coordinate, its derivatives along `u` and along `v`.
+  const auto& derivatives = data.values[1];
+  const index_t target_dim = std::min<index_t>(3, positions.rows());
+  assert(positions.cols() == points.cols() && derivatives.rows() == 2 * positions.rows());
+
+  std::vector<real_t> positions3(3 * points.cols(), 0);
+  std::vector<real_t> normals(3 * points.cols());
+  for(index_t k = 0; k < points.cols(); ++k) {
+    vector3_t du{}, dv{};
+    for(index_t d = 0; d < target_dim; ++d) {
+      positions3[3 * k + d] = positions(d, k);
+      du[d] = derivatives(2 * d, k);
+      dv[d] = derivatives(2 * d + 1, k);
+    }
+    write_normal(du, dv, &normals[3 * k]);
+  }
+  pack_vertices(positions3.data(), normals.data(), points.cols(), out);
+}
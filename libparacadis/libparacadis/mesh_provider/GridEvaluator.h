@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "BasisGridCache.h"
+#include "Tessellation.h"
+
+#include <vector>
+
+namespace Mesh
+{
+  /**
+   * Positions and unit normals of a surface on a tensor grid of parameters.
+   *
+   * Positions and first derivatives are computed in the same pass,
+   * and the normal is \f$\partial_u S \times \partial_v S\f$.
+   *
+   * When the basis is a tensor product (B-splines or NURBS),
+   * the 1-D basis functions and their derivatives are evaluated
+   * only once for each sample of each direction,
+   * and kept in a BasisGridCache for the next tessellation.
+   * Each row of the grid contracts the coefficients along `v`,
+   * and then each point combines only the functions active along `u`.
+   * Other surfaces fall back to the geometry's own evaluation.
+   *
+   * Different rows can be evaluated concurrently.
+   */
+  class GridEvaluator
+  {
+  public:
+    /// Floats written for each point: the position and the normal.
+    static constexpr size_t entries = 6;
+
+    /**
+     * @param surface must outlive the evaluator.
+     * @param samples parameter values along `u` and along `v`.
+     * @param cache where basis grids are looked up.
+     */
+    GridEvaluator(const iga_geometry_t& surface,
+                  std::vector<std::vector<real_t>> samples,
+                  BasisGridCache& cache = BasisGridCache::global());
+
+    index_t cols() const { return index_t(samples[0].size()); }
+    index_t rows() const { return index_t(samples[1].size()); }
+
+    /// Whether the tensor structure of the basis is used.
+    bool isTensor() const { return bool(grid); }
+
+    /**
+     * Writes the points of rows [first_row, first_row + row_count)
+     * to @a out, with `u` varying faster.
+     *
+     * Where the surface is degenerate (at a pole, for instance),
+     * the normal is zero.
+     */
+    void evaluate(index_t first_row, index_t row_count, float* out) const;
+
+  private:
+    const iga_geometry_t&            surface;
+    std::vector<std::vector<real_t>> samples;
+
+    /// Only for tensor bases.
+    BasisGridCache::grid_t grid;
+    /// Each coefficient times its weight, followed by the weight.
+    std::vector<real_t> homogeneous;
+
+    void evaluateTensor(index_t first_row, index_t row_count, float* out) const;
+    void evaluateGeneric(index_t first_row, index_t row_count, float* out) const;
+  };
+}
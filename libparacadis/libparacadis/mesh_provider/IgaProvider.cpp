@@ -29,8 +29,11 @@ using namespace Mesh;
 /**
  * IgaGeometryHolder
  */
-void IgaGeometryHolder::setIgaGeometry(std::shared_ptr<const iga_geometry_t> value)
+void IgaGeometryHolder::setIgaGeometry(std::shared_ptr<const iga_geometry_t> value,
+                                       std::shared_ptr<const Document::AnalyticShape> shape)
 {
+  // The shape first: whoever sees the new geometry also sees its shape.
+  analyticShape = std::move(shape);
   igaGeometry = std::move(value);
   igaChangedSig.emit_signal();
 }
@@ -62,5 +65,9 @@ void IgaProvider::slotUpdate()
 {
   auto geometry = geometryWeak.lock();
   if(!geometry) { return; }
-  setIgaGeometry(geometry->getIgaGeometry().sliced());
+  std::shared_ptr<const Document::AnalyticShape> shape;
+  if(auto analytic = geometry->getAnalyticShape()) {
+    shape = std::make_shared<const Document::AnalyticShape>(*analytic);
+  }
+  setIgaGeometry(geometry->getIgaGeometry().sliced(), std::move(shape));
 }
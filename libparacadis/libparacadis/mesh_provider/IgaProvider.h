@@ -47,6 +47,8 @@ namespace Mesh
   /**
    * Holds (shared_ptr to) a constant IgA geometry and emits a signal
    * when the shared_ptr changes.
+   *
+   * For analytic primitives, it also holds their exact shape.
    */
   class IgaGeometryHolder
   {
@@ -55,6 +57,9 @@ namespace Mesh
 
     std::shared_ptr<const iga_geometry_t> getIgaGeometry() const
     {return igaGeometry.load();}
+    /// Not null only for analytic primitives.
+    std::shared_ptr<const Document::AnalyticShape> getAnalyticShape() const
+    {return analyticShape.load();}
 
     /**
      * Signals that the IgA data structure was changed and is ready.
@@ -62,9 +67,11 @@ namespace Mesh
     Threads::Signal<> igaChangedSig;
 
   protected:
-    void setIgaGeometry(std::shared_ptr<const iga_geometry_t> value);
+    void setIgaGeometry(std::shared_ptr<const iga_geometry_t> value,
+                        std::shared_ptr<const Document::AnalyticShape> shape = {});
 
     std::atomic<std::shared_ptr<const iga_geometry_t>> igaGeometry;
+    std::atomic<std::shared_ptr<const Document::AnalyticShape>> analyticShape;
   };
 
 
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <vector>
+
+namespace Mesh
+{
+  /**
+   * The bookkeeping of a cache that drops its least recently used
+   * entries when their size grows beyond a capacity (in bytes).
+   *
+   * It is not thread safe: caches keep it under their own mutex.
+   * Evicted keys are returned, so what they refer to
+   * (a file, for instance) is released after unlocking.
+   */
+  template<typename Key, typename Value, typename Hash = std::hash<Key>>
+  class LruIndex
+  {
+  public:
+    explicit LruIndex(size_t capacity_bytes) : capacity(capacity_bytes) {}
+
+    /**
+     * The value for @a key, now the most recently used, or nullptr.
+     */
+    Value* find(const Key& key);
+
+    /**
+     * Adds (or replaces) the value for @a key, which takes @a bytes,
+     * as the most recently used.
+     * @returns the keys evicted to make room.
+     */
+    std::vector<Key> insert(const Key& key, Value value, size_t bytes);
+
+    void erase(const Key& key);
+    void clear();
+
+    /// @returns the keys evicted.
+    std::vector<Key> setCapacity(size_t capacity_bytes);
+    size_t getCapacity() const { return capacity; }
+
+    size_t size() const { return entries.size(); }
+    size_t getBytes() const { return bytes; }
+    std::uint64_t getEvictions() const { return evictions; }
+
+  private:
+    struct entry_t
+    {
+      Key    key;
+      Value  value;
+      size_t bytes;
+    };
+
+    /// Most recently used first.
+    std::list<entry_t> entries;
+    std::unordered_map<Key, typename std::list<entry_t>::iterator, Hash> index;
+
+    size_t        capacity;
+    size_t        bytes = 0;
+    std::uint64_t evictions = 0;
+
+    std::vector<Key> evict();
+  };
+}
+
+#include "LruIndex.hpp"
@@ -0,0 +1,90 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "LruIndex.h"
+
+namespace Mesh
+{
+  template<typename Key, typename Value, typename Hash>
+  Value* LruIndex<Key, Value, Hash>::find(const Key& key)
+  {
+    auto it = index.find(key);
+    if(it == index.end()) {
+      return nullptr;
+    }
+    entries.splice(entries.begin(), entries, it->second);
+    return &it->second->value;
+  }
+
+  template<typename Key, typename Value, typename Hash>
+  std::vector<Key> LruIndex<Key, Value, Hash>::insert(const Key& key, Value value,
+                                                      size_t value_bytes)
+  {
+    erase(key);
+    entries.push_front({key, std::move(value), value_bytes});
+    index.emplace(key, entries.begin());
+    bytes += value_bytes;
+    return evict();
+  }
+
+  template<typename Key, typename Value, typename Hash>
+  void LruIndex<Key, Value, Hash>::erase(const Key& key)
+  {
+    if(auto it = index.find(key); it != index.end()) {
+      bytes -= it->second->bytes;
+      entries.erase(it->second);
+      index.erase(it);
+    }
+  }
+
+  template<typename Key, typename Value, typename Hash>
+  void LruIndex<Key, Value, Hash>::clear()
+  {
+    index.clear();
+    entries.clear();
+    bytes = 0;
+  }
+
+  template<typename Key, typename Value, typename Hash>
+  std::vector<Key> LruIndex<Key, Value, Hash>::setCapacity(size_t capacity_bytes)
+  {
+    capacity = capacity_bytes;
+    return evict();
+  }
+
+  template<typename Key, typename Value, typename Hash>
+  std::vector<Key> LruIndex<Key, Value, Hash>::evict()
+  {
+    std::vector<Key> evicted;
+    while(bytes > capacity && !entries.empty()) {
+      auto& last = entries.back();
+      bytes -= last.bytes;
+      index.erase(last.key);
+      evicted.push_back(std::move(last.key));
+      entries.pop_back();
+      ++evictions;
+    }
+    return evicted;
+  }
+}
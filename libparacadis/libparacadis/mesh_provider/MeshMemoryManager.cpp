@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+#include "MeshMemoryManager.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace Mesh;
+
+MeshMemoryManager& MeshMemoryManager::global()
+{
+  static MeshMemoryManager manager;
+  return manager;
+}
+
+void MeshMemoryManager::setGpuBudget(size_t bytes)
+{
+  std::scoped_lock lock{mutex};
+  gpuBudget = bytes;
+}
+
+size_t MeshMemoryManager::getGpuBudget() const
+{
+  std::scoped_lock lock{mutex};
+  return gpuBudget;
+}
+
+MeshMemoryUsage MeshMemoryManager::getTotal() const
+{
+  std::scoped_lock lock{mutex};
+  return total;
+}
+
+void MeshMemoryManager::add(const std::shared_ptr<ManagedMesh>& mesh)
+{
+  std::scoped_lock lock{mutex};
+  meshes.try_emplace(mesh.get(), entry_t{.mesh = mesh, .usage = {}});
+}
+
+void MeshMemoryManager::remove(const ManagedMesh* mesh)
+{
+  std::scoped_lock lock{mutex};
+  auto it = meshes.find(mesh);
+  if(it == meshes.end()) {
+    return;
+  }
+  total.cpuBytes -= it->second.usage.cpuBytes;
+  total.gpuBytes -= it->second.usage.gpuBytes;
+  meshes.erase(it);
+}
+
+void MeshMemoryManager::report(const ManagedMesh* mesh, MeshMemoryUsage usage)
+{
+  std::scoped_lock lock{mutex};
+  auto it = meshes.find(mesh);
+  if(it == meshes.end()) {
+    return;
+  }
+  auto& entry = it->second;
+  total.cpuBytes += usage.cpuBytes - entry.usage.cpuBytes;
+  total.gpuBytes += usage.gpuBytes - entry.usage.gpuBytes;
+  entry.usage = usage;
+}
+
+void MeshMemoryManager::enforce()
+{
+  std::vector<std::weak_ptr<ManagedMesh>> loaded;
+  size_t excess = 0;
+  {
+    std::scoped_lock lock{mutex};
+    if(total.gpuBytes <= gpuBudget) {
+      return;
+    }
+    excess = total.gpuBytes - gpuBudget;
+    for(const auto& [key, entry]: meshes) {
+      if(entry.usage.gpuBytes > 0) {
+        loaded.push_back(entry.mesh);
+      }
+    }
+  }
+
+  // Meshes are locked, and unloaded, without holding the lock: they report to us.
+  const std::uint64_t current = frame;
+  std::vector<std::pair<std::uint64_t, std::shared_ptr<ManagedMesh>>> candidates;
+  for(const auto& weak_mesh: loaded) {
+    auto mesh = weak_mesh.lock();
+    if(!mesh) {
+      continue;
+    }
+    const auto last_rendered = mesh->getLastRendered();
+    if(last_rendered + 1 < current) {
+      candidates.emplace_back(last_rendered, std::move(mesh));
+    }
+  }
+  std::ranges::sort(candidates, {}, [](const auto& c) { return c.first; });
+
+  for(auto& [last_rendered, mesh]: candidates) {
+    const auto freed = mesh->getMemoryUsage().gpuBytes;
+    mesh->unload();
+    if(freed >= excess) {
+      return;
+    }
+    excess -= freed;
+  }
+}
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+namespace Mesh
+{
+  /**
+   * Memory taken by meshes.
+   */
+  struct MeshMemoryUsage
+  {
+    /// Tessellations held by the meshes (maybe shared by several of them).
+    size_t cpuBytes = 0;
+    /// Vertex and index buffers.
+    size_t gpuBytes = 0;
+  };
+
+  /**
+   * What the MeshMemoryManager needs from a mesh (an OgreGismoMesh).
+   */
+  class ManagedMesh
+  {
+  public:
+    virtual ~ManagedMesh() = default;
+
+    virtual MeshMemoryUsage getMemoryUsage() const = 0;
+    /**
+     * The last frame (see MeshMemoryManager::frameStarted())
+     * in which it was rendered, or uploaded.
+     */
+    virtual std::uint64_t getLastRendered() const = 0;
+    /**
+     * Releases the GPU buffers, and reports it.
+     *
+     * @attention Call it from the GL thread.
+     */
+    virtual void unload() = 0;
+  };
+
+  /**
+   * Keeps the GPU memory taken by every mesh within a budget.
+   *
+   * Meshes report what they hold whenever it changes.
+   * When the total goes over the budget, meshes that were not rendered
+   * in the last frames (out of view, or hidden) are unloaded,
+   * the ones rendered longer ago first.
+   * They are tessellated again (or taken from the TessellationCache)
+   * when they are rendered again.
+   *
+   * Meshes release their CPU copy once it is uploaded,
+   * so the CPU side is mostly bounded by the TessellationCache capacity.
+   */
+  class MeshMemoryManager
+  {
+  public:
+    static constexpr size_t default_gpu_budget = size_t(1024) * 1024 * 1024;
+
+    static MeshMemoryManager& global();
+
+    /**
+     * It is enforced the next time a mesh is uploaded.
+     */
+    void   setGpuBudget(size_t bytes);
+    size_t getGpuBudget() const;
+
+    MeshMemoryUsage getTotal() const;
+
+    /**
+     * Called by the meshes.
+     */
+    /// @{
+    void add(const std::shared_ptr<ManagedMesh>& mesh);
+    void remove(const ManagedMesh* mesh);
+    void report(const ManagedMesh* mesh, MeshMemoryUsage usage);
+    /// @}
+
+    /**
+     * Counts frames, for ManagedMesh::getLastRendered().
+     *
+     * @attention Call it from the GL thread, when a frame starts.
+     */
+    /// @{
+    void          frameStarted() { ++frame; }
+    std::uint64_t getFrame() const { return frame; }
+    /// @}
+
+    /**
+     * Unloads meshes that were not rendered in this frame or in the previous one
+     * until the GPU memory fits the budget.
+     *
+     * @attention Call it from the GL thread.
+     */
+    void enforce();
+
+  private:
+    struct entry_t
+    {
+      std::weak_ptr<ManagedMesh> mesh;
+      MeshMemoryUsage            usage;
+    };
+
+    std::atomic<std::uint64_t> frame = 1;
+
+    mutable std::mutex mutex;
+    std::unordered_map<const ManagedMesh*, entry_t> meshes;
+    MeshMemoryUsage total;
+    size_t          gpuBudget = default_gpu_budget;
+  };
+}
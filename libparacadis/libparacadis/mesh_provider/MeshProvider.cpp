@@ -24,6 +24,7 @@
 
 #include "OgreGismoMesh.h"
 
+#include <cassert>
 #include <memory>
 
 using namespace Mesh;
@@ -31,24 +32,33 @@ using namespace Mesh;
 /*
  * MeshProvider
  */
-MeshProvider::MeshProvider(SharedPtr<IgaProvider> iga_provider)
+MeshProvider::MeshProvider(SharedPtr<IgaProvider> iga_provider,
+                           const TessellationParameters& parameters)
     : igaProvider(std::move(iga_provider))
-    , mesh(igaProvider->getIgaGeometry())
-{}
+    , tessellationParameters(parameters)
+{
+  if(!isCurve()) {
+    // Always shown by itself: start tessellating right away.
+    getMesh(true);
+  }
+}
 
 SharedPtr<MeshProvider>
 MeshProvider::make_shared(SharedPtr<native_geometry_t> geometry,
-                          const SharedPtr<Threads::SignalQueue>& queue)
+                          const SharedPtr<Threads::SignalQueue>& queue,
+                          const TessellationParameters& parameters)
 {
   auto iga_provider = IgaProvider::make_shared(std::move(geometry), queue);
-  return make_shared(std::move(iga_provider), queue);
+  return make_shared(std::move(iga_provider), queue, parameters);
 }
 
 SharedPtr<MeshProvider>
 MeshProvider::make_shared(SharedPtr<IgaProvider> iga_provider,
-                          const SharedPtr<Threads::SignalQueue>& queue)
+                          const SharedPtr<Threads::SignalQueue>& queue,
+                          const TessellationParameters& parameters)
 {
-  auto self = SharedPtr<MeshProvider>::from_pointer(new MeshProvider(iga_provider));
+  auto self = SharedPtr<MeshProvider>::from_pointer(
+      new MeshProvider(iga_provider, parameters));
   iga_provider->igaChangedSig.connect(
       std::move(iga_provider), queue, self, &MeshProvider::slotUpdate);
   return self;
@@ -56,5 +66,102 @@ MeshProvider::make_shared(SharedPtr<IgaProvider> iga_provider,
 
 void MeshProvider::slotUpdate()
 {
-  mesh->resetIgaGeometry(igaProvider->getIgaGeometry());
+  std::shared_ptr<OgreGismoMesh> own;
+  std::vector<SharedPtr<CurveBatch>> live;
+  {
+    std::scoped_lock lock{mutex};
+    own = mesh;
+    for(const auto& batch_weak: batches) {
+      auto batch = batch_weak.lock();
+      if(batch) {
+        live.push_back(std::move(batch));
+      }
+    }
+  }
+
+  // Runs in the SignalQueue consumer: the meshes only schedule the tessellation.
+  if(own && live.empty()) {
+    own->resetIgaGeometry(igaProvider->getIgaGeometry(), igaProvider->getAnalyticShape());
+  }
+  for(const auto& batch: live) {
+    batch->setCurve(this, igaProvider->getIgaGeometry(), igaProvider->getAnalyticShape());
+  }
+}
+
+std::shared_ptr<OgreGismoMesh> MeshProvider::getMesh(bool create)
+{
+  std::scoped_lock lock{mutex};
+  if(!mesh && create) {
+    mesh = SharedPtrWrap<OgreGismoMesh>(igaProvider->getIgaGeometry(), tessellationParameters,
+                                        OgreGismoMesh::default_lod_levels,
+                                        igaProvider->getAnalyticShape()).sliced();
+  }
+  return mesh;
+}
+
+const SharedPtr<Ogre::Mesh>& MeshProvider::getOgreMesh()
+{
+  // The mesh is kept until the provider is destroyed.
+  return getMesh(true)->getOgreMesh();
+}
+
+void MeshProvider::setVisible(bool visible)
+{
+  const auto own = getMesh(visible);
+  if(own) {
+    own->setVisible(visible);
+  }
+}
+
+void MeshProvider::trackEntity(Ogre::MovableObject* entity)
+{
+  getMesh(true)->trackEntity(entity);
+}
+
+void MeshProvider::setTessellationParameters(const TessellationParameters& parameters)
+{
+  std::shared_ptr<OgreGismoMesh> own;
+  {
+    std::scoped_lock lock{mutex};
+    tessellationParameters = parameters;
+    own = mesh;
+  }
+  if(own) {
+    own->setTessellationParameters(parameters);
+  }
+}
+
+bool MeshProvider::isCurve() const
+{
+  const auto igaGeo = igaProvider->getIgaGeometry();
+  return igaGeo && igaGeo->parDim() == 1;
+}
+
+void MeshProvider::addToBatch(const SharedPtr<CurveBatch>& batch)
+{
+  assert(isCurve() && "Only curves can be batched.");
+  std::scoped_lock lock{mutex};
+  std::erase_if(batches, [](const auto& weak) { return !weak.lock(); });
+  batches.push_back(batch);
+  batch->setCurve(this, igaProvider->getIgaGeometry(), igaProvider->getAnalyticShape());
+}
+
+void MeshProvider::removeFromBatch(const SharedPtr<CurveBatch>& batch)
+{
+  std::shared_ptr<OgreGismoMesh> stale;
+  {
+    std::scoped_lock lock{mutex};
+    std::erase_if(batches, [&](const auto& weak) {
+      const auto locked = weak.lock();
+      return !locked || locked.get() == batch.get();
+    });
+    if(batches.empty()) {
+      // Not updated while batched.
+      stale = mesh;
+    }
+  }
+  batch->removeCurve(this);
+  if(stale) {
+    stale->resetIgaGeometry(igaProvider->getIgaGeometry(), igaProvider->getAnalyticShape());
+  }
 }
@@ -22,11 +22,15 @@
 
 #pragma once
 
+#include "CurveBatch.h"
 #include "IgaProvider.h"
 #include "OgreGismoMesh.h"
 
 #include <libparacadis/base/expected_behaviour/SharedPtrWrap.h>
 
+#include <mutex>
+#include <vector>
+
 namespace Mesh
 {
   class MeshProvider
@@ -34,20 +38,53 @@ namespace Mesh
   public:
     static SharedPtr<MeshProvider>
     make_shared(SharedPtr<native_geometry_t> geometry,
-                const SharedPtr<Threads::SignalQueue>& queue);
+                const SharedPtr<Threads::SignalQueue>& queue,
+                const TessellationParameters& parameters = {});
 
     static SharedPtr<MeshProvider>
     make_shared(SharedPtr<IgaProvider> provider,
-                const SharedPtr<Threads::SignalQueue>& queue);
+                const SharedPtr<Threads::SignalQueue>& queue,
+                const TessellationParameters& parameters = {});
+
+    /**
+     * Its own mesh is created when first needed:
+     * curves drawn in a CurveBatch usually never need one.
+     */
+    /// @{
+    const SharedPtr<Ogre::Mesh>& getOgreMesh();
+    void setVisible(bool visible);
+    /// See OgreGismoMesh::trackEntity().
+    void trackEntity(Ogre::MovableObject* entity);
+    /// @}
 
-    const SharedPtr<Ogre::Mesh>& getOgreMesh() const
-    { return mesh->getOgreMesh(); }
+    void setTessellationParameters(const TessellationParameters& parameters);
+
+    /// The geometry is a curve, so it can be drawn in a CurveBatch.
+    bool isCurve() const;
+    /**
+     * Draws the curve in @a batch, and keeps it updated there.
+     * Its own mesh (if any) is neither shown nor tessellated meanwhile.
+     */
+    /// @{
+    void addToBatch(const SharedPtr<CurveBatch>& batch);
+    void removeFromBatch(const SharedPtr<CurveBatch>& batch);
+    /// @}
 
   protected:
-    MeshProvider(SharedPtr<IgaProvider> iga_provider);
+    MeshProvider(SharedPtr<IgaProvider> iga_provider,
+                 const TessellationParameters& parameters);
     void slotUpdate();
+    /// Creates the mesh if @a create and it does not exist yet.
+    std::shared_ptr<OgreGismoMesh> getMesh(bool create);
 
     const SharedPtr<IgaProvider> igaProvider;
-    SharedPtrWrap<OgreGismoMesh> mesh;
+
+    std::mutex mutex;
+    /// Null until needed. Protected by `mutex`.
+    std::shared_ptr<OgreGismoMesh> mesh;
+    /// Protected by `mutex`.
+    TessellationParameters tessellationParameters;
+    /// Protected by `mutex`.
+    std::vector<WeakPtr<CurveBatch>> batches;
   };
 }
@@ -23,39 +23,133 @@
 #include "OgreGismoMesh.h"
 
 #include "GlThreadQueue.h"
+#include "Tessellation.h"
+#include "TessellationResult.h"
+
+#include <libparacadis/base/expected_behaviour/SharedPtrWrap.h>
+#include <libparacadis/base/threads/thread_pool/TaskGroup.h>
 
 #include <gismo/gismo.h>
 
+#include <OGRE/OgreDistanceLodStrategy.h>
 #include <OGRE/OgreHardwareBufferManager.h>
 #include <OGRE/OgreMeshManager.h>
 #include <OGRE/OgreRoot.h>
+#include <OGRE/OgreSceneNode.h>
 #include <OGRE/OgreSubMesh.h>
 
+#include <algorithm>
 #include <atomic>
+#include <cmath>
 #include <memory>
 #include <format>
 
 using namespace Mesh;
 
 namespace {
+  /// Chordal tolerance ratio between consecutive levels of detail.
+  constexpr real_t lod_tolerance_factor = 4;
+  /**
+   * A level of detail is used when its chordal error
+   * projects to less than about one pixel:
+   * beyond the distance `tolerance * lod_pixels_per_radian`.
+   * (A 1080 pixels high viewport with a 45 degrees field of view.)
+   */
+  constexpr real_t lod_pixels_per_radian = 1300;
+
+  /**
+   * Previews of edits are tessellated with the tolerance of this level
+   * of detail, whatever the number of levels.
+   */
+  constexpr int preview_level = 3;
+
+  TessellationParameters coarser(TessellationParameters parameters, int level)
+  {
+    parameters.chordalTolerance *= std::pow(lod_tolerance_factor, level);
+    return parameters;
+  }
+
+  /**
+   * Writes the blocks of @a chunk's vertex data whose hashes are not in
+   * @a written (what the buffer holds), merging contiguous blocks.
+   * Everything is written if we know nothing about the buffer.
+   */
+  void write_changed_blocks(Ogre::HardwareBuffer& buffer, const MeshChunk& chunk,
+                            std::vector<std::uint64_t>& written)
+  {
+    const auto* data = static_cast<const char*>(chunk.vertexData());
+    const size_t bytes = chunk.vertexBytes();
+    const auto& hashes = chunk.blockHashes;
+
+    if(hashes.empty() || written.empty()) {
+      buffer.writeData(0, bytes, data, true);
+    } else {
+      auto unchanged = [&](size_t block) {
+        return block < written.size() && written[block] == hashes[block];
+      };
+      for(size_t block = 0; block < hashes.size(); ) {
+        if(unchanged(block)) {
+          ++block;
+          continue;
+        }
+        size_t end = block + 1;
+        while(end < hashes.size() && !unchanged(end)) {
+          ++end;
+        }
+        const size_t offset = block * MeshChunk::hash_block_bytes;
+        const size_t length = std::min(bytes, end * MeshChunk::hash_block_bytes) - offset;
+        buffer.writeData(offset, length, data + offset, false);
+        block = end;
+      }
+    }
+    written = hashes;
+  }
+
+  /**
+   * Counts frames for the MeshMemoryManager.
+   */
+  struct FrameCounter
+      : public Ogre::FrameListener
+  {
+    bool frameStarted(const Ogre::FrameEvent& /*evt*/) override
+    {
+      MeshMemoryManager::global().frameStarted();
+      return true;
+    }
+  };
+
   GlThreadQueue& register_queue()
   {
+    static FrameCounter counter;
     static GlThreadQueue listener;
+    Ogre::Root::getSingleton().addFrameListener(&counter);
     Ogre::Root::getSingleton().addFrameListener(&listener);
     return listener;
   }
 
-  auto& get_queue()
+  GlThreadQueue& get_queue()
   {
     static GlThreadQueue& listener = register_queue();
-    return listener.queue;
+    return listener;
   }
 }
 
 
-OgreGismoMesh::OgreGismoMesh(std::shared_ptr<const iga_geometry_t> iga_geometry)
-    : igaGeometry(std::move(iga_geometry))
+OgreGismoMesh::OgreGismoMesh(std::shared_ptr<const iga_geometry_t> iga_geometry,
+                             const TessellationParameters& parameters,
+                             int lod_levels,
+                             std::shared_ptr<const Document::AnalyticShape> shape)
+    : igaGeometry(iga_geometry)
+    , analyticShape(shape)
+    , tessellationParameters(parameters)
 {
+  // Coarsest first: they are prepared as soon as constructed.
+  coarserLevels.resize(std::max(0, lod_levels - 1));
+  for(int level = lod_levels - 1; level > 0; --level) {
+    coarserLevels[level-1] = SharedPtrWrap<OgreGismoMesh>(
+        iga_geometry, coarser(parameters, level), 1, shape);
+  }
+
   using namespace Ogre;
 
   static std::atomic<unsigned int> counter = 0;
@@ -67,305 +161,550 @@ OgreGismoMesh::OgreGismoMesh(std::shared_ptr<const iga_geometry_t> iga_geometry)
   mesh->setBackgroundLoaded(true);
 }
 
+OgreGismoMesh::~OgreGismoMesh()
+{
+  MeshMemoryManager::global().remove(this);
+  for(auto* entity: entities) {
+    entity->setListener(nullptr);
+  }
+}
+
 void OgreGismoMesh::init()
 {
+  MeshMemoryManager::global().add(shared_from_this());
+  setLodUsages();
   mesh->prepare();
 }
 
-void OgreGismoMesh::resetIgaGeometry(SharedPtr<const iga_geometry_t> iga_geometry)
+void OgreGismoMesh::setLodUsages()
 {
-  igaGeometry = iga_geometry.sliced();
-  justPrepare();
+  using namespace Ogre;
 
-  auto lambda = [weak_self = weak_from_this()]{
+  if(coarserLevels.empty()) {
+    return;
+  }
+
+  auto* strategy = DistanceLodSphereStrategy::getSingletonPtr();
+  mesh->setLodStrategy(strategy);
+  mesh->_setLodInfo(coarserLevels.size() + 1);
+  for(size_t k = 0; k < coarserLevels.size(); ++k) {
+    const auto& level = coarserLevels[k];
+    const auto tolerance = level->getTessellationParameters().chordalTolerance;
+
+    MeshLodUsage usage;
+    usage.userValue = tolerance * lod_pixels_per_radian;
+    usage.value = strategy->transformUserValue(usage.userValue);
+    usage.manualName = level->getOgreMesh()->getName();
+    usage.manualMesh = level->getOgreMesh().sliced();
+    usage.edgeData = nullptr;
+    mesh->_setLodUsage(k + 1, usage);
+  }
+}
+
+void OgreGismoMesh::resetIgaGeometry(SharedPtr<const iga_geometry_t> iga_geometry,
+                                     std::shared_ptr<const Document::AnalyticShape> shape)
+{
+  const auto generation = ++editGeneration;
+  Threads::CancellationToken cancel;
+  {
+    std::scoped_lock lock{mutex};
+    refinement.cancel();
+    refinement = cancel;
+  }
+
+  std::shared_ptr<const iga_geometry_t> igaGeo = iga_geometry.sliced();
+  edited = true;
+  analyticShape = shape;
+  igaGeometry = igaGeo;
+  for(auto& level: coarserLevels) {
+    level->edited = true;
+    level->analyticShape = shape;
+    level->igaGeometry = igaGeo;
+  }
+
+  // We are probably in the SignalQueue consumer: it only schedules.
+  auto preview = [weak_self = weak_from_this(), igaGeo, shape, generation, cancel] {
     auto self = weak_self.lock();
-    if(!self) {
+    if(!self || cancel.isCancelled()) {
+      // A newer edit.
       return;
     }
-    self->loadResource(self->mesh.get());
-    self->mesh->_dirtyState();
+    self->showPreview(igaGeo, shape, cancel);
+    // Only now, so a slow preview never replaces the refined tessellation.
+    self->scheduleRefinement(generation, cancel);
   };
-  get_queue().push(lambda);
+  Threads::ThreadPool::global().submit(std::move(preview));
 }
 
+void OgreGismoMesh::showPreview(const std::shared_ptr<const iga_geometry_t>& igaGeo,
+                                const std::shared_ptr<const Document::AnalyticShape>& shape,
+                                const Threads::CancellationToken& cancel)
+{
+  const auto parameters = coarser(getTessellationParameters(), preview_level);
+  auto tessellated = tessellate(*igaGeo, parameters, cancel, shape.get());
+  if(cancel.isCancelled()) {
+    return;
+  }
+  const auto preview = std::make_shared<const TessellationResult>(std::move(tessellated));
+
+  auto show = [&](OgreGismoMesh& level) {
+    {
+      std::scoped_lock lock{level.mutex};
+      if(level.igaGeometry.load() != igaGeo) {
+        // A newer edit.
+        return;
+      }
+      level.tessellation = preview;
+      level.streaming = true;
+      level.reportMemory();
+    }
+    level.queueUpload(UploadPriority::EDITED);
+  };
+  show(*this);
+  for(auto& level: coarserLevels) {
+    show(*level);
+  }
+}
 
-size_t OgreGismoMesh::vertexEntriesPerPoint() const
+void OgreGismoMesh::scheduleRefinement(std::uint64_t generation, Threads::CancellationToken cancel)
 {
-  assert(dimension && "The dimension was supposed to be set.");
-  return ((dimension == 1) ? 3 : 6);
+  auto refine = [weak_self = weak_from_this(), generation, cancel] {
+    auto self = weak_self.lock();
+    if(!self || self->editGeneration != generation) {
+      // Still editing.
+      return;
+    }
+    // Coarsest first: distant views are sharp sooner.
+    for(auto it = self->coarserLevels.rbegin(); it != self->coarserLevels.rend(); ++it) {
+      (*it)->justPrepare(cancel);
+      if(cancel.isCancelled()) {
+        return;
+      }
+      (*it)->queueUpload(UploadPriority::EDITED);
+    }
+    self->justPrepare(cancel);
+    if(!cancel.isCancelled()) {
+      self->queueUpload(UploadPriority::EDITED);
+    }
+  };
+  Threads::ThreadPool::global().submitAfter(refine_delay, std::move(refine));
 }
 
+void OgreGismoMesh::showTessellation(TessellationCache::tessellation_t result)
+{
+  assert(!igaGeometry.load() && "The mesh tessellates its own geometry.");
+  {
+    std::scoped_lock lock{mutex};
+    external = result;
+    tessellation = std::move(result);
+    streaming = false;
+    reportMemory();
+  }
+  queueUpload(UploadPriority::HIDDEN);
+}
 
-void OgreGismoMesh::prepareResource(Ogre::Resource*)
+void OgreGismoMesh::setTessellationParameters(const TessellationParameters& parameters)
 {
-  justPrepare();
+  {
+    std::scoped_lock lock{mutex};
+    if(tessellationParameters == parameters) {
+      return;
+    }
+    tessellationParameters = parameters;
+  }
+  for(size_t k = coarserLevels.size(); k > 0; --k) {
+    coarserLevels[k-1]->setTessellationParameters(coarser(parameters, k));
+  }
+  prepareInBackground(UploadPriority::HIDDEN);
+}
 
-  auto lambda = [weak_self = weak_from_this()]{
+void OgreGismoMesh::prepareInBackground(UploadPriority priority)
+{
+  Threads::ThreadPool::global().submit([weak_self = weak_from_this(), priority] {
     auto self = weak_self.lock();
     if(!self) {
       return;
     }
-      self->mesh->escalateLoading();
-  };
-  get_queue().push(lambda);
+    self->justPrepare();
+    self->queueUpload(priority);
+  });
 }
 
-void OgreGismoMesh::justPrepare()
+TessellationParameters OgreGismoMesh::getTessellationParameters() const
 {
-  auto igaGeo = igaGeometry.load();
-  if(!igaGeo) {
-    return;
-  }
-  dimension = igaGeo->parDim();
+  std::scoped_lock lock{mutex};
+  return tessellationParameters;
+}
 
-  if(dimension == 1) {
-    prepareCurve(igaGeo);
-  } else if(dimension == 2) {
-    prepareSurface(igaGeo);
-  } else {
-    assert(false && "Must be a curve or a surface.");
-    return;
+void OgreGismoMesh::setVisible(bool is_visible)
+{
+  visible = is_visible;
+  for(auto& level: coarserLevels) {
+    level->setVisible(is_visible);
   }
 }
 
-void OgreGismoMesh::loadResource(Ogre::Resource*)
+void OgreGismoMesh::trackEntity(Ogre::MovableObject* entity)
 {
-  using namespace Ogre;
+  entity->setListener(this);
   std::scoped_lock lock{mutex};
-  assert(dimension != 0 && "Parameter dimension not set.");
-  assert(dimension < 3 && "Must be a curve or a surface.");
+  entities.push_back(entity);
+  applyFrame();
+}
 
-  mesh->_setBounds(AxisAlignedBox(min_bound, max_bound));
+void OgreGismoMesh::objectDestroyed(Ogre::MovableObject* object)
+{
+  std::scoped_lock lock{mutex};
+  std::erase(entities, object);
+}
 
-  if(!mesh->sharedVertexData) {
-    setVertexData();
-  }
-  prepareHardwareBuffers();
+bool OgreGismoMesh::objectRendering(const Ogre::MovableObject*, const Ogre::Camera*)
+{
+  markRendered(MeshMemoryManager::global().getFrame());
+  return true;
+}
 
-  assert(!mesh->getSubMeshes().empty());
+void OgreGismoMesh::markRendered(std::uint64_t frame)
+{
+  lastRendered = frame;
+  if(evicted && evicted.exchange(false)) {
+    prepareInBackground(UploadPriority::VISIBLE);
+  }
+  for(auto& level: coarserLevels) {
+    level->markRendered(frame);
+  }
+}
 
-  SubMesh* sub = mesh->getSubMeshes()[0];
-  sub->operationType = (dimension == 1) ? RenderOperation::OT_LINE_STRIP
-                                        : RenderOperation::OT_TRIANGLE_STRIP;
-  //    sub->useSharedVertices = true;
-  sub->indexData->indexBuffer = ibuf;
-  sub->indexData->indexStart = 0;
-  sub->indexData->indexCount = indexes.size();
+void OgreGismoMesh::applyFrame() const
+{
+  const Ogre::Vector3 offset(frame.offset.data());
+  for(auto* entity: entities) {
+    if(auto* node = entity->getParentSceneNode()) {
+      node->setPosition(offset);
+      node->setScale(frame.scale, frame.scale, frame.scale);
+    }
+  }
 }
 
+GlThreadQueue::Metrics OgreGismoMesh::getUploadMetrics()
+{
+  return get_queue().getMetrics();
+}
 
-void OgreGismoMesh::prepareCurve(const std::shared_ptr<const iga_geometry_t>& igaGeo)
+void OgreGismoMesh::queueUpload(UploadPriority priority)
 {
-  using namespace Ogre;
+  if(priority == UploadPriority::HIDDEN && visible) {
+    priority = UploadPriority::VISIBLE;
+  }
 
-  const gismo::gsMatrix<real_t> param = igaGeo->parameterRange();
-  // TODO: decide sample size according to some precise mathematical criteria.
-  gismo::gsGridIterator<real_t, gismo::CUBE> pIter(param, 100);
+  size_t bytes = 0;
+  {
+    std::scoped_lock lock{mutex};
+    if(tessellation) {
+      bytes = tessellation->byteSize();
+    }
+  }
 
-  const auto np = pIter.numPointsCwise();
-  const auto npoints = np[0];
+  auto lambda = [weak_self = weak_from_this()]{
+    auto self = weak_self.lock();
+    if(!self) {
+      return;
+    }
+    if(self->mesh->isLoaded()) {
+      self->loadResource(self->mesh.get());
+      self->mesh->_dirtyState();
+    } else {
+      self->mesh->escalateLoading();
+    }
+    MeshMemoryManager::global().enforce();
+  };
+  get_queue().pushUpload({.key = this, .priority = priority,
+                          .bytes = bytes, .upload = std::move(lambda)});
+}
+
+
+std::vector<Ogre::AxisAlignedBox> OgreGismoMesh::getChunkBounds() const
+{
+  std::scoped_lock lock{mutex};
+  return chunkBounds;
+}
+
+MeshMemoryUsage OgreGismoMesh::getMemoryUsage() const
+{
+  std::scoped_lock lock{mutex};
+  return memoryUsage();
+}
 
-  std::vector<float> positions;
-  std::vector<Ogre::uint16> local_indexes;
+MeshMemoryUsage OgreGismoMesh::memoryUsage() const
+{
+  MeshMemoryUsage usage;
+  if(tessellation) {
+    usage.cpuBytes = tessellation->byteSize();
+  }
+  for(const auto& chunk_buffers: buffers) {
+    for(const auto* buffer: {(const Ogre::HardwareBuffer*)chunk_buffers.vbuf.get(),
+                             (const Ogre::HardwareBuffer*)chunk_buffers.backVbuf.get(),
+                             (const Ogre::HardwareBuffer*)chunk_buffers.ibuf.get()}) {
+      if(buffer) {
+        usage.gpuBytes += buffer->getSizeInBytes();
+      }
+    }
+  }
+  return usage;
+}
 
-  auto local_min_bound = Vector3::ZERO;
-  auto local_max_bound = Vector3::ZERO;
+void OgreGismoMesh::reportMemory() const
+{
+  MeshMemoryManager::global().report(this, memoryUsage());
+}
 
-  positions.reserve(vertexEntriesPerPoint() * npoints);
-  local_indexes.reserve(npoints);
+void OgreGismoMesh::unload()
+{
+  std::scoped_lock lock{mutex};
+  while(mesh->getNumSubMeshes() > 0) {
+    mesh->destroySubMesh(mesh->getNumSubMeshes() - 1);
+  }
+  // Entities drop their SubEntities.
+  mesh->_dirtyState();
+  buffers.clear();
+  chunkBounds.clear();
+  evicted = true;
+  reportMemory();
+}
 
-  auto domain_points = pIter.toMatrix();
-  // TODO: process in parallel.
-  auto _positions  = igaGeo->eval(domain_points);
-  assert(_positions.cols() == npoints
-         && "Wrong number of positions predicted.");
-  for(int i=0; i < _positions.cols(); ++i) {
-    auto const& pcol = _positions.col(i);
+bool OgreGismoMesh::isSuperseded(const std::shared_ptr<const iga_geometry_t>& igaGeo,
+                                 const TessellationParameters& parameters) const
+{
+  return igaGeometry.load() != igaGeo || tessellationParameters != parameters;
+}
 
-    Vector3 pos(pcol[0], pcol[1], pcol[2]);
-    // Sets the bounding box.
-    local_min_bound.makeFloor(pos);
-    local_max_bound.makeCeil(pos);
+void OgreGismoMesh::prepareResource(Ogre::Resource*)
+{
+  // Called by init(), in whatever thread creates the mesh.
+  prepareInBackground(UploadPriority::HIDDEN);
+}
 
-    // Sets the positions
-    positions.push_back(pos[0]);
-    positions.push_back(pos[1]);
-    positions.push_back(pos[2]);
+void OgreGismoMesh::justPrepare(const Threads::CancellationToken& cancel)
+{
+  auto igaGeo = igaGeometry.load();
+  if(!igaGeo) {
+    // Tessellated by someone else (see showTessellation()), or nothing.
+    std::scoped_lock lock{mutex};
+    tessellation = external;
+    streaming = false;
+    reportMemory();
+    return;
+  }
+  // Loaded after the geometry: it is at least as new.
+  const auto shape = analyticShape.load();
+  const auto parameters = getTessellationParameters();
 
-    local_indexes.push_back(i);
+  auto result = TessellationCache::global().tessellate(*igaGeo, parameters, cancel, shape.get(),
+                                                      !edited);
+  if(!result) {
+    return;
   }
 
   std::scoped_lock lock{mutex};
-  vertex  = std::move(positions);
-  indexes = std::move(local_indexes);
-  min_bound = local_min_bound;
-  max_bound = local_max_bound;
+  if(cancel.isCancelled() || isSuperseded(igaGeo, parameters)) {
+    return;
+  }
+  tessellation = std::move(result);
+  streaming = false;
+  reportMemory();
 }
 
-void OgreGismoMesh::prepareSurface(const std::shared_ptr<const iga_geometry_t>& igaGeo)
+void OgreGismoMesh::loadResource(Ogre::Resource*)
 {
   using namespace Ogre;
 
-  gismo::gsNormalField<real_t> normal_field{*igaGeo};
-
-  const gismo::gsMatrix<real_t> param = igaGeo->parameterRange();
-  // TODO: decide sample size according to some precise mathematical criteria.
-  gismo::gsGridIterator<real_t, gismo::CUBE> pIter(param, 1000);
-
-  const auto np = pIter.numPointsCwise();
-  const auto npoints = np[0] * np[1];
-  const auto ntriangles = 2 * (np[0]-1) * (np[1]-1);
-
-  std::vector<float> positions_normals;
-  std::vector<Ogre::uint16> triangles;
-
-  auto local_min_bound = Vector3::ZERO;
-  auto local_max_bound = Vector3::ZERO;
-
-  positions_normals.reserve(vertexEntriesPerPoint() * npoints);
-  triangles.reserve(2 * 3 * ntriangles);
-
-  auto domain_points = pIter.toMatrix();
-  // TODO: process in parallel.
-  auto _positions  = igaGeo->eval(domain_points);
-  auto _normals = normal_field.eval(domain_points);
-  assert(_positions.cols() == npoints
-         && "Wrong number of positions predicted.");
-  assert(_positions.cols() == _normals.cols()
-         && "We should have one normal for each vertex.");
-  for(int i=0; i < _positions.cols(); ++i) {
-    auto const& pcol = _positions.col(i);
-    auto const& ncol = _normals.col(i);
-
-    Vector3 pos(pcol[0], pcol[1], pcol[2]);
-    Vector3 normal(ncol[0], ncol[1], ncol[2]);
-    normal.normalise();
-
-    // Sets the bounding box.
-    local_min_bound.makeFloor(pos);
-    local_max_bound.makeCeil(pos);
-
-    // Sets the positions
-    positions_normals.push_back(pos[0]);
-    positions_normals.push_back(pos[1]);
-    positions_normals.push_back(pos[2]);
-    // Sets the normals
-    positions_normals.push_back(normal[0]);
-    positions_normals.push_back(normal[1]);
-    positions_normals.push_back(normal[2]);
-  }
-
-  for(index_t j = 0; j < np[1]-1; ++j) {
-    for(index_t i= 0; i < np[0]-1; ++i) {
-      const index_t ind1 = j * np[0] + i;
-      const index_t ind2 = ind1 + np[0];
-      triangles.push_back(ind1);
-      triangles.push_back(ind1+1);
-      triangles.push_back(ind2+1);
-      triangles.push_back(ind1);
-      triangles.push_back(ind2+1);
-      triangles.push_back(ind1+1);
-
-      triangles.push_back(ind2+1);
-      triangles.push_back(ind2);
-      triangles.push_back(ind1);
-      triangles.push_back(ind2+1);
-      triangles.push_back(ind1);
-      triangles.push_back(ind2);
+  std::scoped_lock lock{mutex};
+  if(!tessellation) {
+    if(mesh->getNumSubMeshes() == 0 && (igaGeometry.load() || external)) {
+      // Loaded again after being unloaded. It stays empty until the upload.
+      prepareInBackground(UploadPriority::VISIBLE);
     }
+    // Otherwise, already uploaded.
+    return;
+  }
+  if(tessellation->dimension == 0) {
+    // Loaded (for a new entity, maybe) before the first tessellation is done.
+    // It stays empty: the upload queued by prepareInBackground() fills it.
+    return;
   }
+  dimension = tessellation->dimension;
+  assert(dimension < 3 && "Must be a curve or a surface.");
 
-  std::scoped_lock lock{mutex};
-  vertex  = std::move(positions_normals);
-  indexes = std::move(triangles);
-  min_bound = local_min_bound;
-  max_bound = local_max_bound;
+  const auto& chunks = tessellation->chunks;
+  AxisAlignedBox bounds;
+  chunkBounds.clear();
+  for(const auto& chunk: chunks) {
+    chunkBounds.emplace_back(Vector3(chunk.min_bound.data()), Vector3(chunk.max_bound.data()));
+    bounds.merge(chunkBounds.back());
+  }
+  // The mesh is bounded in the space of its vertices, before the node scales them.
+  frame = tessellation->frame;
+  if(bounds.isFinite()) {
+    const Vector3 offset(frame.offset.data());
+    bounds.setExtents((bounds.getMinimum() - offset) / frame.scale,
+                      (bounds.getMaximum() - offset) / frame.scale);
+  }
+  mesh->_setBounds(bounds);
+  applyFrame();
+
+  // One SubMesh for each chunk, with the vertex declaration of the chunks.
+  const bool compact = !chunks.empty() && chunks.front().isCompact();
+  if(compact != compactSubMeshes) {
+    while(mesh->getNumSubMeshes() > 0) {
+      mesh->destroySubMesh(mesh->getNumSubMeshes() - 1);
+    }
+    compactSubMeshes = compact;
+    vblock_size = 0;
+  }
+  while(mesh->getNumSubMeshes() > chunks.size()) {
+    mesh->destroySubMesh(mesh->getNumSubMeshes() - 1);
+  }
+  // New SubMeshes (also after Ogre unloads the mesh) need new buffers.
+  buffers.resize(std::min(buffers.size(), size_t(mesh->getNumSubMeshes())));
+  while(mesh->getNumSubMeshes() < chunks.size()) {
+    createChunkSubMesh(compact);
+  }
+  buffers.resize(chunks.size());
+
+  for(size_t k = 0; k < chunks.size(); ++k) {
+    prepareHardwareBuffers(k);
+
+    SubMesh* sub = mesh->getSubMesh(k);
+    if(dimension == 1) {
+      sub->operationType = tessellation->lineList ? RenderOperation::OT_LINE_LIST
+                                                  : RenderOperation::OT_LINE_STRIP;
+    } else {
+      sub->operationType = RenderOperation::OT_TRIANGLE_LIST;
+    }
+    sub->indexData->indexBuffer = buffers[k].ibuf;
+    sub->indexData->indexStart = 0;
+    sub->indexData->indexCount = chunks[k].indexCount();
+  }
+
+  // Just uploaded: it gets a frame or two to be rendered.
+  lastRendered = MeshMemoryManager::global().getFrame();
+  evicted = false;
+  // It can be taken from the TessellationCache, or tessellated, again.
+  tessellation.reset();
+  reportMemory();
 }
 
 
-void OgreGismoMesh::setVertexData()
+void OgreGismoMesh::createChunkSubMesh(bool compact)
 {
   using namespace Ogre;
 
   assert(dimension && "The dimension was supposed to be set.");
-
   assert(mesh);
 
-  assert(mesh->getSubMeshes().empty());
-  mesh->createSubMesh();
-
-  assert(!mesh->sharedVertexData);
-  mesh->createVertexData();
+  SubMesh* sub = mesh->createSubMesh();
+  sub->useSharedVertices = false;
+  sub->vertexData = OGRE_NEW VertexData();
 
-  auto* vdata = mesh->sharedVertexData;
-  auto* decl = vdata->vertexDeclaration;
-  vdata->vertexCount = vertexEntriesPerPoint();
-
-  assert(vblock_size == 0 && "VertexData can only be set once.");
-  vblock_size += decl->addElement(0, vblock_size, VET_FLOAT3, VES_POSITION).getSize();
+  auto* decl = sub->vertexData->vertexDeclaration;
+  size_t block_size = 0;
+  const auto position_type = compact ? VET_SHORT4_NORM : VET_FLOAT3;
+  block_size += decl->addElement(0, block_size, position_type, VES_POSITION).getSize();
   if(dimension == 2) {
-    vblock_size += decl->addElement(0, vblock_size, VET_FLOAT3, VES_NORMAL).getSize();
+    const auto normal_type = compact ? VET_BYTE4_NORM : VET_FLOAT3;
+    block_size += decl->addElement(0, block_size, normal_type, VES_NORMAL).getSize();
   }
+  assert((vblock_size == 0 || vblock_size == block_size)
+         && "Every chunk has the same vertex declaration.");
+  vblock_size = block_size;
 }
 
 
-void OgreGismoMesh::prepareHardwareBuffers()
+void OgreGismoMesh::prepareHardwareBuffers(size_t chunk_index)
 {
   using namespace Ogre;
 
+  const auto& chunk = tessellation->chunks[chunk_index];
+  auto& chunk_buffers = buffers[chunk_index];
+  auto* vdata = mesh->getSubMesh(chunk_index)->vertexData;
+
+  auto& manager = HardwareBufferManager::getSingleton();
+
   // Vertexes.
+  const size_t vertex_count = chunk.vertexBytes() / vblock_size;
   bool need_vertex_buffer = false;
 
-  if(vertex_buffer_size <= 0) {
+  if(chunk_buffers.vertex_buffer_size <= 0 || chunk_buffers.streaming != streaming) {
     need_vertex_buffer = true;
-    vertex_buffer_size = 1;
+    chunk_buffers.vertex_buffer_size = 1;
+    chunk_buffers.streaming = streaming;
   }
 
-  auto needed_vertex_size = std::max(vertex.size(), vertexEntriesPerPoint());
-  while(vertex_buffer_size < needed_vertex_size) {
+  auto needed_vertex_size = std::max(vertex_count, (size_t)1);
+  while(chunk_buffers.vertex_buffer_size < needed_vertex_size) {
     need_vertex_buffer = true;
-    vertex_buffer_size *= 2;
+    chunk_buffers.vertex_buffer_size *= 2;
   }
-  while(vertex_buffer_size > 4*needed_vertex_size) {
+  while(chunk_buffers.vertex_buffer_size > 4*needed_vertex_size) {
     need_vertex_buffer = true;
-    vertex_buffer_size /= 2;
+    chunk_buffers.vertex_buffer_size /= 2;
   }
 
+  // Edited meshes stream to dynamic buffers, and settle in static ones.
+  const auto usage = streaming ? HBU_CPU_TO_GPU : HBU_GPU_ONLY;
   if(need_vertex_buffer) {
-    auto* vdata = mesh->sharedVertexData;
-    auto* bind = vdata->vertexBufferBinding;
-
-    vbuf = HardwareBufferManager::getSingleton().createVertexBuffer(
-        vblock_size, vertex_buffer_size/vertexEntriesPerPoint(), HBU_GPU_ONLY);
-    bind->setBinding(0, vbuf);
+    chunk_buffers.vbuf = manager.createVertexBuffer(
+        vblock_size, chunk_buffers.vertex_buffer_size, usage);
+    chunk_buffers.blockHashes.clear();
+    chunk_buffers.backVbuf.reset();
+    chunk_buffers.backBlockHashes.clear();
+  } else if(streaming) {
+    if(!chunk_buffers.backVbuf) {
+      chunk_buffers.backVbuf = manager.createVertexBuffer(
+          vblock_size, chunk_buffers.vertex_buffer_size, usage);
+    }
+    std::swap(chunk_buffers.vbuf, chunk_buffers.backVbuf);
+    std::swap(chunk_buffers.blockHashes, chunk_buffers.backBlockHashes);
   }
-  auto vbyte_count = vblock_size*vertex.size()/vertexEntriesPerPoint();
-  assert(vbyte_count <= vbuf->getSizeInBytes());
-  vbuf->writeData(0, sizeof(float)*vertex.size(), vertex.data(), true);
+  vdata->vertexBufferBinding->setBinding(0, chunk_buffers.vbuf);
+  vdata->vertexStart = 0;
+  vdata->vertexCount = vertex_count;
+  assert(chunk.vertexBytes() <= chunk_buffers.vbuf->getSizeInBytes());
+  write_changed_blocks(*chunk_buffers.vbuf, chunk, chunk_buffers.blockHashes);
 
 
   // Indexes
+  const auto index_type = chunk.isWide() ? HardwareIndexBuffer::IT_32BIT
+                                         : HardwareIndexBuffer::IT_16BIT;
+  const size_t index_bytes = chunk.isWide() ? sizeof(Ogre::uint32) : sizeof(Ogre::uint16);
+  const void* index_data = chunk.isWide() ? (const void*)chunk.wideIndexes.data()
+                                          : (const void*)chunk.indexes.data();
+
   bool need_index_buffer = false;
-  if(index_buffer_size <= 0) {
+  if(chunk_buffers.index_buffer_size <= 0 || chunk_buffers.ibuf->getType() != index_type) {
     need_index_buffer = true;
-    index_buffer_size = 1;
+    chunk_buffers.index_buffer_size = 1;
   }
 
-  auto needed_index_size = std::max(indexes.size(), (size_t)1);
-  while(index_buffer_size < needed_index_size) {
+  auto needed_index_size = std::max(chunk.indexCount(), (size_t)1);
+  while(chunk_buffers.index_buffer_size < needed_index_size) {
     need_index_buffer = true;
-    index_buffer_size *= 2;
+    chunk_buffers.index_buffer_size *= 2;
   }
 
-  while(index_buffer_size > 4*needed_index_size) {
+  while(chunk_buffers.index_buffer_size > 4*needed_index_size) {
     need_index_buffer = true;
-    index_buffer_size /= 2;
+    chunk_buffers.index_buffer_size /= 2;
   }
 
   if(need_index_buffer) {
-    ibuf = HardwareBufferManager::getSingleton().createIndexBuffer(
-        HardwareIndexBuffer::IT_16BIT, index_buffer_size, HBU_GPU_ONLY);
+    chunk_buffers.ibuf = manager.createIndexBuffer(
+        index_type, chunk_buffers.index_buffer_size, HBU_GPU_ONLY);
+  } else if(chunk_buffers.indexHash == chunk.indexHash && chunk.indexHash != 0) {
+    // Same topology: edits usually only move the vertices.
+    return;
   }
-  assert(sizeof(Ogre::uint16)*indexes.size() <= ibuf->getSizeInBytes());
-  ibuf->writeData(0, sizeof(Ogre::uint16)*indexes.size(), indexes.data(), true);
+  assert(index_bytes*chunk.indexCount() <= chunk_buffers.ibuf->getSizeInBytes());
+  chunk_buffers.ibuf->writeData(0, index_bytes*chunk.indexCount(), index_data, true);
+  chunk_buffers.indexHash = chunk.indexHash;
 }
@@ -22,14 +22,27 @@
 
 #pragma once
 
+#include "GlThreadQueue.h"
+#include "MeshMemoryManager.h"
+#include "Tessellation.h"
+#include "TessellationCache.h"
+#include "TessellationResult.h"
+
 #include <libparacadis/base/expected_behaviour/SharedPtr.h>
 #include <libparacadis/base/geometric_primitives/DocumentGeometry.h>
+#include <libparacadis/base/threads/thread_pool/TaskGroup.h>
 
+#include <OGRE/OgreAxisAlignedBox.h>
 #include <OGRE/OgreMesh.h>
+#include <OGRE/OgreMovableObject.h>
 #include <OGRE/OgreResource.h>
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <memory>
 #include <mutex>
+#include <vector>
 
 namespace Mesh
 {
@@ -40,52 +53,274 @@ namespace Mesh
    * A mesh for the IgA geometries provided by G+Smo.
    *
    * This class contains an Ogre::Mesh and a mesh loader that
-   * converts the G+Smo geometry to the Ogre::Mesh.
+   * uploads the TessellationResult of the G+Smo geometry to the Ogre::Mesh.
+   *
+   * It also holds a chain of coarser levels of detail:
+   * each one is an OgreGismoMesh with a larger chordal tolerance.
+   * They are registered as Ogre manual LOD levels of the finest mesh
+   * and selected by the camera distance.
+   *
+   * Tessellations are computed in the thread pool, never in the caller's
+   * thread (for instance, the SignalQueue consumer that calls
+   * resetIgaGeometry() must not be blocked by a heavy surface).
+   * Each one enqueues its upload to the GL thread when it is done.
+   * Coarse levels are constructed, and so scheduled, first.
+   * Until a level is tessellated, it shows what it had (or nothing).
+   *
+   * Tessellations are shared, through the TessellationCache,
+   * with every other mesh of the same shape and parameters.
+   * The mesh drops its reference once the tessellation is uploaded,
+   * and the MeshMemoryManager unloads it when it is out of view
+   * and GPU memory is short. Its entities (see trackEntity())
+   * tell when it is rendered.
+   *
+   * Edits are shown progressively: a coarse preview is tessellated
+   * immediately, and the full resolution one is only computed after
+   * the edits stop for a while (see resetIgaGeometry()).
+   *
+   * Compact surfaces are quantized (see QuantizationFrame):
+   * the SceneNode of each entity of the mesh (see trackEntity())
+   * scales them back. Levels of detail share the frame of the geometry.
    */
   class OgreGismoMesh
       : public Ogre::ManualResourceLoader
+      , public Ogre::MovableObject::Listener
+      , public ManagedMesh
       , public std::enable_shared_from_this<OgreGismoMesh>
   {
   public:
-    OgreGismoMesh(std::shared_ptr<const iga_geometry_t> iga_geometry);
+    /// Levels of detail, including the finest one.
+    static constexpr int default_lod_levels = 4;
+    /// Idle time after an edit before tessellating at full resolution.
+    static constexpr std::chrono::milliseconds refine_delay{150};
+
+    /**
+     * @param shape the exact shape of @a iga_geometry, for analytic primitives.
+     * See TessellationParameters::analyticShapes.
+     */
+    OgreGismoMesh(std::shared_ptr<const iga_geometry_t> iga_geometry,
+                  const TessellationParameters& parameters = {},
+                  int lod_levels = default_lod_levels,
+                  std::shared_ptr<const Document::AnalyticShape> shape = {});
+    ~OgreGismoMesh() override;
     void init();
 
-    void resetIgaGeometry(SharedPtr<const iga_geometry_t> iga_geometry);
+    /**
+     * Shows the new geometry of an edit.
+     *
+     * Only schedules work: it returns right away.
+     * Every level of detail shows a coarse preview as soon as it is
+     * tessellated in the thread pool.
+     * They are refined once no other edit arrives for `refine_delay`.
+     * A newer edit cancels the ongoing preview and refinement.
+     */
+    void resetIgaGeometry(SharedPtr<const iga_geometry_t> iga_geometry,
+                          std::shared_ptr<const Document::AnalyticShape> shape = {});
     const SharedPtr<Ogre::Mesh>& getOgreMesh() const {return mesh;}
 
+    /**
+     * Shows @a result, tessellated by someone else (like a CurveBatch),
+     * instead of a geometry of its own.
+     *
+     * The mesh must have been constructed without a geometry.
+     * It keeps @a result, to upload it again after being unloaded.
+     */
+    void showTessellation(TessellationCache::tessellation_t result);
+
+    /**
+     * Tessellates again if the parameters change.
+     */
+    void setTessellationParameters(const TessellationParameters& parameters);
+    TessellationParameters getTessellationParameters() const;
+
+    /**
+     * Visible meshes are uploaded to the GPU before hidden ones.
+     */
+    void setVisible(bool is_visible);
+
+    /**
+     * Keeps the SceneNode of @a entity, an entity of this mesh,
+     * in the QuantizationFrame of the uploaded vertices.
+     * The node must hold nothing else: it is scaled.
+     *
+     * The mesh becomes the entity's listener, until one of them is destroyed:
+     * when the entity is rendered, the mesh is kept in the GPU
+     * (see MeshMemoryManager), or loaded again.
+     */
+    void trackEntity(Ogre::MovableObject* entity);
+
+    static GlThreadQueue::Metrics getUploadMetrics();
+
+    /**
+     * Bounds of each uploaded chunk (each Ogre::SubMesh), for culling.
+     * In the space of the geometry, before the QuantizationFrame.
+     */
+    std::vector<Ogre::AxisAlignedBox> getChunkBounds() const;
+
+    MeshMemoryUsage getMemoryUsage() const override;
+    std::uint64_t   getLastRendered() const override { return lastRendered; }
+
+    /**
+     * Releases the GPU buffers and the SubMeshes.
+     * The Ogre::Mesh stays loaded, with its bounds: its entities are culled
+     * as before, and it is prepared again in the thread pool
+     * when one of them is rendered.
+     *
+     * @attention Call it from the GL thread.
+     */
+    void unload() override;
+
   protected:
-    void justPrepare();
+    /**
+     * Tessellates the current geometry and parameters.
+     * The result is dropped if @a cancel is cancelled meanwhile.
+     */
+    void justPrepare(const Threads::CancellationToken& cancel = {});
+    /**
+     * Tessellates in the thread pool, and then queues the upload.
+     */
+    void prepareInBackground(UploadPriority priority);
+    /**
+     * Schedules the upload of the prepared data in the GL thread.
+     */
+    void queueUpload(UploadPriority priority);
     void prepareResource(Ogre::Resource* resource) override;
     void loadResource(Ogre::Resource* resource) override;
+    void objectDestroyed(Ogre::MovableObject* object) override;
+    bool objectRendering(const Ogre::MovableObject* object,
+                         const Ogre::Camera* camera) override;
 
   private:
     SharedPtr<Ogre::Mesh> mesh;
     std::atomic<std::shared_ptr<const iga_geometry_t>> igaGeometry;
+    /// Set before igaGeometry, so it is never older.
+    std::atomic<std::shared_ptr<const Document::AnalyticShape>> analyticShape;
+    std::atomic<bool> visible = false;
+
+    mutable std::mutex mutex;
+
+    TessellationParameters tessellationParameters;
+
+    /// Coarser levels of detail, from finer to coarser.
+    std::vector<SharedPtr<OgreGismoMesh>> coarserLevels;
+    /// Registers coarserLevels in the Ogre::Mesh.
+    void setLodUsages();
 
-    std::mutex mutex;
+    /// Incremented by each edit, so delayed refinements know they are obsolete.
+    std::atomic<std::uint64_t> editGeneration = 0;
+    /// Set by the first edit (also in coarserLevels): from then on,
+    /// tessellations are not kept in the TessellationDiskCache.
+    std::atomic<bool> edited = false;
+    /// Cancels the refinement of the last edit. Protected by `mutex`.
+    Threads::CancellationToken refinement;
 
-    // Prepared data.
-    std::vector<float> vertex;
-    std::vector<Ogre::uint16> indexes;
-    Ogre::Vector3 min_bound;
-    Ogre::Vector3 max_bound;
+    /**
+     * Tessellates @a igaGeo coarsely and shows it in every level of detail,
+     * unless @a cancel is cancelled by a newer edit.
+     */
+    void showPreview(const std::shared_ptr<const iga_geometry_t>& igaGeo,
+                     const std::shared_ptr<const Document::AnalyticShape>& shape,
+                     const Threads::CancellationToken& cancel);
+    /**
+     * Refines every level, coarsest first, after `refine_delay`,
+     * unless another edit comes first.
+     */
+    void scheduleRefinement(std::uint64_t generation, Threads::CancellationToken cancel);
+
+    /**
+     * Prepared data, until it is uploaded.
+     * Shared with the TessellationCache and with other meshes of the same shape.
+     */
+    TessellationCache::tessellation_t tessellation =
+        std::make_shared<const TessellationResult>();
+    /// Set by showTessellation(). Protected by `mutex`.
+    TessellationCache::tessellation_t external;
+    /**
+     * The tessellation is an edit preview: it will be replaced soon,
+     * probably by something similar.
+     * So it is uploaded to dynamic, double buffered vertex buffers.
+     */
+    bool streaming = false;
 
     // Buffers.
-    int dimension = 0;
+    struct chunk_buffers_t
+    {
+      /// In indexes and vertices.
+      /// @{
+      size_t index_buffer_size = 0;
+      size_t vertex_buffer_size = 0;
+      /// @}
+
+      Ogre::HardwareVertexBufferSharedPtr vbuf;
+      Ogre::HardwareIndexBufferSharedPtr ibuf;
+
+      /// What was written to `vbuf` and `ibuf`.
+      /// @{
+      std::vector<std::uint64_t> blockHashes;
+      std::uint64_t              indexHash = 0;
+      /// @}
+
+      /**
+       * When streaming, the vertex buffer drawn by the previous frame.
+       * The next upload goes to this one instead, so it does not wait for the GPU.
+       */
+      /// @{
+      bool                                streaming = false;
+      Ogre::HardwareVertexBufferSharedPtr backVbuf;
+      std::vector<std::uint64_t>          backBlockHashes;
+      /// @}
+    };
+
+    std::atomic<int> dimension = 0;
     size_t vblock_size = 0;
-    size_t index_buffer_size = 0;
-    size_t vertex_buffer_size = 0;
+    /// Vertex declaration of the SubMeshes.
+    bool compactSubMeshes = false;
+    std::vector<chunk_buffers_t> buffers;
+    std::vector<Ogre::AxisAlignedBox> chunkBounds;
+    /// Of the uploaded vertices. Protected by `mutex`.
+    QuantizationFrame frame;
+
+    /// See trackEntity(). Protected by `mutex`.
+    std::vector<Ogre::MovableObject*> entities;
 
-    Ogre::HardwareVertexBufferSharedPtr vbuf;
-    Ogre::HardwareIndexBufferSharedPtr ibuf;
+    /// See MeshMemoryManager::getFrame().
+    std::atomic<std::uint64_t> lastRendered = MeshMemoryManager::global().getFrame();
+    /// Unloaded by the MeshMemoryManager, and not prepared again yet.
+    std::atomic<bool> evicted = false;
+    /**
+     * Stamps `lastRendered`, and prepares the mesh again if it was evicted.
+     * The levels of detail too: the camera can switch to any of them.
+     */
+    void markRendered(std::uint64_t frame);
+    /**
+     * Puts `frame` in the nodes of `entities`.
+     * @attention Call it holding `mutex`.
+     */
+    void applyFrame() const;
 
-    size_t vertexEntriesPerPoint() const;
+    /**
+     * What we hold, and telling the MeshMemoryManager about it.
+     * @attention Call them holding `mutex`.
+     */
+    /// @{
+    MeshMemoryUsage memoryUsage() const;
+    void reportMemory() const;
+    /// @}
 
-    void setVertexData();
+    /**
+     * The geometry or the parameters changed since we started tessellating.
+     * A newer tessellation is on its way, so we drop ours.
+     *
+     * @attention Call it holding `mutex`.
+     */
+    bool isSuperseded(const std::shared_ptr<const iga_geometry_t>& igaGeo,
+                      const TessellationParameters& parameters) const;
 
-    void prepareCurve(const std::shared_ptr<const iga_geometry_t>& igaGeo);
-    void prepareSurface(const std::shared_ptr<const iga_geometry_t>& igaGeo);
+    /**
+     * Adds a SubMesh (with its own vertex data) for one more chunk.
+     */
+    void createChunkSubMesh(bool compact);
 
-    void prepareHardwareBuffers();
+    void prepareHardwareBuffers(size_t chunk_index);
   };
 }
@@ -0,0 +1,415 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "Tessellation.h"
+
+#include <gismo/gismo.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+namespace Mesh
+{
+  namespace {
+    /// Points probed in each knot span, along the refined direction.
+    constexpr index_t probes_along = 5;
+    /// Points probed across the other directions.
+    constexpr index_t probes_across = 9;
+    /// Intervals of each knot span where curves are probed.
+    constexpr index_t curve_probe_intervals = 16;
+
+    /**
+     * 64-bit FNV-1a.
+     */
+    class Hasher
+    {
+    public:
+      void add(const void* data, size_t size)
+      {
+        const auto* bytes = static_cast<const unsigned char*>(data);
+        for(size_t i = 0; i < size; ++i) {
+          value = (value ^ bytes[i]) * 1099511628211ull;
+        }
+      }
+
+      template<typename T>
+        requires std::is_trivially_copyable_v<T>
+      void add(const T& v) { add(&v, sizeof(T)); }
+
+      void add(const gismo::gsMatrix<real_t>& m)
+      {
+        add(m.rows());
+        add(m.cols());
+        add(m.data(), sizeof(real_t) * m.size());
+      }
+
+      std::uint64_t get() const { return value; }
+
+    private:
+      std::uint64_t value = 14695981039346656037ull;
+    };
+
+    /**
+     * Degrees and knots of @a basis, along its first @a dimension directions.
+     */
+    void add_knots(Hasher& hasher, const gismo::gsBasis<real_t>& basis, short_t dimension)
+    {
+      for(short_t d = 0; d < dimension; ++d) {
+        try {
+          hasher.add(basis.degree(d));
+          for(const real_t knot: basis.knots(d)) {
+            hasher.add(knot);
+          }
+        } catch(const std::exception&) {
+          // Not a B-spline basis: the coefficients must do.
+        }
+      }
+    }
+
+    /**
+     * Breakpoints (distinct knots) of the basis along @a direction.
+     */
+    std::vector<real_t> breakpoints(const iga_geometry_t& geometry, short_t direction)
+    {
+      const gismo::gsMatrix<real_t> range = geometry.parameterRange();
+      std::vector<real_t> result{range(direction, 0), range(direction, 1)};
+
+      try {
+        const auto& basis = geometry.basis().component(direction);
+        for(auto it = basis.makeDomainIterator(); it->good(); it->next()) {
+          result.push_back(it->lowerCorner()[0]);
+          result.push_back(it->upperCorner()[0]);
+        }
+      } catch(const std::exception&) {
+        // Not a tensor basis: a single span.
+      }
+
+      std::ranges::sort(result);
+      auto [first, last] = std::ranges::unique(result);
+      result.erase(first, last);
+      return result;
+    }
+
+    std::vector<real_t> uniform(real_t a, real_t b, index_t n)
+    {
+      std::vector<real_t> result(n);
+      for(index_t k = 0; k < n; ++k) {
+        result[k] = a + (b - a) * k / std::max<index_t>(1, n - 1);
+      }
+      return result;
+    }
+
+    /**
+     * Maximum norm of the second derivative along @a direction
+     * in the span [a, b].
+     */
+    real_t max_curvature(const iga_geometry_t& geometry, short_t direction,
+                         real_t a, real_t b)
+    {
+      const short_t par_dim = geometry.parDim();
+      const gismo::gsMatrix<real_t> range = geometry.parameterRange();
+
+      std::vector<std::vector<real_t>> samples(par_dim);
+      for(short_t d = 0; d < par_dim; ++d) {
+        samples[d] = (d == direction)
+                         ? uniform(a, b, probes_along)
+                         : uniform(range(d, 0), range(d, 1), probes_across);
+      }
+      const auto points = grid_points(samples);
+
+      /*
+       * For each point, the second derivatives come as
+       * (d11 f1, d22 f1, ..., d12 f1, ..., d11 f2, ...).
+       */
+      const auto second = geometry.deriv2(points);
+      const index_t stride = par_dim * (par_dim + 1) / 2;
+      const index_t target_dim = geometry.targetDim();
+      assert(second.rows() == stride * target_dim);
+
+      real_t result = 0;
+      for(index_t p = 0; p < second.cols(); ++p) {
+        real_t norm2 = 0;
+        for(index_t c = 0; c < target_dim; ++c) {
+          const real_t v = second(c * stride + direction, p);
+          norm2 += v * v;
+        }
+        result = std::max(result, norm2);
+      }
+      return std::sqrt(result);
+    }
+  }
+
+
+  std::vector<real_t>
+  adaptive_samples(const iga_geometry_t& geometry, short_t direction,
+                   const TessellationParameters& parameters)
+  {
+    assert(parameters.chordalTolerance > 0);
+    assert(parameters.minSegmentsPerSpan >= 1);
+    assert(parameters.minSegmentsPerSpan <= parameters.maxSegmentsPerSpan);
+
+    const auto knots = breakpoints(geometry, direction);
+    std::vector<real_t> result{knots.front()};
+
+    for(size_t k = 0; k + 1 < knots.size(); ++k) {
+      const real_t a = knots[k];
+      const real_t b = knots[k+1];
+
+      const real_t curvature = max_curvature(geometry, direction, a, b);
+      real_t segments =
+          std::ceil((b - a) * std::sqrt(curvature / (8 * parameters.chordalTolerance)));
+      if(!std::isfinite(segments)) {
+        segments = parameters.maxSegmentsPerSpan;
+      }
+      const int n = std::clamp(
+          static_cast<int>(std::min<real_t>(segments, parameters.maxSegmentsPerSpan)),
+          parameters.minSegmentsPerSpan, parameters.maxSegmentsPerSpan);
+
+      for(int i = 1; i <= n; ++i) {
+        result.push_back(a + (b - a) * i / n);
+      }
+    }
+
+    return result;
+  }
+
+
+  std::vector<real_t>
+  curve_samples(const iga_geometry_t& geometry, const TessellationParameters& parameters)
+  {
+    assert(geometry.parDim() == 1);
+    assert(parameters.chordalTolerance > 0);
+    assert(parameters.minSegmentsPerSpan >= 1);
+    assert(parameters.minSegmentsPerSpan <= parameters.maxSegmentsPerSpan);
+
+    const auto knots = breakpoints(geometry, 0);
+    std::vector<real_t> result{knots.front()};
+
+    const index_t target_dim = geometry.targetDim();
+    std::vector<real_t> arc(curve_probe_intervals + 1);
+    for(size_t k = 0; k + 1 < knots.size(); ++k) {
+      const real_t a = knots[k];
+      const real_t b = knots[k+1];
+
+      const auto probes = uniform(a, b, curve_probe_intervals + 1);
+      const auto points = grid_points({probes});
+      const auto first = geometry.deriv(points);
+      const auto second = geometry.deriv2(points);
+      assert(first.rows() == target_dim && second.rows() == target_dim);
+
+      /*
+       * Arc length (trapezoidal rule) and curvature:
+       * |C' x C''| / |C'|^3, with |C' x C''|^2 = |C'|^2 |C''|^2 - (C'.C'')^2
+       * in any dimension.
+       */
+      real_t curvature = 0;
+      real_t previous_speed = 0;
+      for(index_t p = 0; p <= curve_probe_intervals; ++p) {
+        real_t d1 = 0;
+        real_t d2 = 0;
+        real_t d12 = 0;
+        for(index_t c = 0; c < target_dim; ++c) {
+          d1 += first(c, p) * first(c, p);
+          d2 += second(c, p) * second(c, p);
+          d12 += first(c, p) * second(c, p);
+        }
+        const real_t speed = std::sqrt(d1);
+        if(speed > 0) {
+          curvature = std::max(curvature, std::sqrt(std::max<real_t>(0, d1 * d2 - d12 * d12))
+                                              / (d1 * speed));
+        }
+        arc[p] = (p == 0) ? 0
+                          : arc[p-1] + (probes[p] - probes[p-1]) * (speed + previous_speed) / 2;
+        previous_speed = speed;
+      }
+      const real_t length = arc.back();
+
+      real_t segments =
+          std::ceil(length * std::sqrt(curvature / (8 * parameters.chordalTolerance)));
+      if(!std::isfinite(segments)) {
+        segments = parameters.maxSegmentsPerSpan;
+      }
+      const int n = std::clamp(
+          static_cast<int>(std::min<real_t>(segments, parameters.maxSegmentsPerSpan)),
+          parameters.minSegmentsPerSpan, parameters.maxSegmentsPerSpan);
+
+      // Inverts the arc length, linearly between probes.
+      size_t probe = 1;
+      for(int i = 1; i < n; ++i) {
+        if(length <= 0) {
+          result.push_back(a + (b - a) * i / n);
+          continue;
+        }
+        const real_t target = length * i / n;
+        while(probe < curve_probe_intervals && arc[probe] < target) {
+          ++probe;
+        }
+        const real_t span = arc[probe] - arc[probe-1];
+        const real_t t = (span > 0) ? (target - arc[probe-1]) / span : 0;
+        result.push_back(probes[probe-1] + t * (probes[probe] - probes[probe-1]));
+      }
+      result.push_back(b);
+    }
+
+    return result;
+  }
+
+
+  std::vector<std::uint32_t>
+  simplify_polyline(const float* points, size_t count, real_t tolerance)
+  {
+    if(count <= 2) {
+      std::vector<std::uint32_t> result(count);
+      for(size_t k = 0; k < count; ++k) {
+        result[k] = k;
+      }
+      return result;
+    }
+
+    auto distance2 = [points](size_t p, size_t a, size_t b) {
+      const float* P = points + 3 * p;
+      const float* A = points + 3 * a;
+      const float* B = points + 3 * b;
+      real_t ab[3], ap[3];
+      real_t ab2 = 0;
+      real_t t = 0;
+      for(int d = 0; d < 3; ++d) {
+        ab[d] = B[d] - A[d];
+        ap[d] = P[d] - A[d];
+        ab2 += ab[d] * ab[d];
+        t += ab[d] * ap[d];
+      }
+      t = (ab2 > 0) ? std::clamp<real_t>(t / ab2, 0, 1) : 0;
+      real_t result = 0;
+      for(int d = 0; d < 3; ++d) {
+        const real_t v = ap[d] - t * ab[d];
+        result += v * v;
+      }
+      return result;
+    };
+
+    // Iterative, so long polylines do not exhaust the stack.
+    std::vector<bool> keep(count, false);
+    keep.front() = keep.back() = true;
+    std::vector<std::pair<size_t, size_t>> pending{{0, count - 1}};
+    const real_t tolerance2 = tolerance * tolerance;
+    while(!pending.empty()) {
+      const auto [a, b] = pending.back();
+      pending.pop_back();
+
+      size_t farthest = a;
+      real_t max_distance2 = tolerance2;
+      for(size_t p = a + 1; p < b; ++p) {
+        if(const real_t d2 = distance2(p, a, b); d2 > max_distance2) {
+          max_distance2 = d2;
+          farthest = p;
+        }
+      }
+      if(farthest != a) {
+        keep[farthest] = true;
+        pending.push_back({a, farthest});
+        pending.push_back({farthest, b});
+      }
+    }
+
+    std::vector<std::uint32_t> result;
+    for(size_t k = 0; k < count; ++k) {
+      if(keep[k]) {
+        result.push_back(k);
+      }
+    }
+    return result;
+  }
+
+
+  gismo::gsMatrix<real_t>
+  grid_points(const std::vector<std::vector<real_t>>& samples)
+  {
+    const index_t dim = samples.size();
+    index_t total = 1;
+    for(const auto& s: samples) {
+      total *= s.size();
+    }
+
+    gismo::gsMatrix<real_t> result(dim, total);
+    for(index_t p = 0; p < total; ++p) {
+      index_t rest = p;
+      for(index_t d = 0; d < dim; ++d) {
+        const index_t n = samples[d].size();
+        result(d, p) = samples[d][rest % n];
+        rest /= n;
+      }
+    }
+    return result;
+  }
+
+
+  std::uint64_t geometry_hash(const iga_geometry_t& geometry)
+  {
+    Hasher hasher;
+    hasher.add(geometry.parDim());
+    hasher.add(geometry.targetDim());
+
+    const auto& basis = geometry.basis();
+    add_knots(hasher, basis, geometry.parDim());
+    if(basis.isRational()) {
+      hasher.add(basis.weights());
+    }
+    hasher.add(geometry.coefs());
+    return hasher.get();
+  }
+
+
+  std::uint64_t analytic_hash(const Document::AnalyticShape& shape)
+  {
+    Hasher hasher;
+    hasher.add(shape.index());
+    if(const auto* sphere = std::get_if<Document::AnalyticSphere>(&shape)) {
+      hasher.add(sphere->center);
+      hasher.add(sphere->radius);
+    } else if(const auto* circle = std::get_if<Document::AnalyticCircle>(&shape)) {
+      hasher.add(circle->center);
+      hasher.add(circle->normal);
+      hasher.add(circle->xdir);
+      hasher.add(circle->radius);
+    }
+    return hasher.get();
+  }
+
+
+  std::uint64_t grid_hash(const gismo::gsBasis<real_t>& basis,
+                          const std::vector<std::vector<real_t>>& samples)
+  {
+    Hasher hasher;
+    hasher.add(samples.size());
+    add_knots(hasher, basis, samples.size());
+    for(const auto& direction: samples) {
+      hasher.add(direction.size());
+      hasher.add(direction.data(), sizeof(real_t) * direction.size());
+    }
+    return hasher.get();
+  }
+}
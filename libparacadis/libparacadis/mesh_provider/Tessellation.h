@@ -0,0 +1,163 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include <libparacadis/base/geometric_primitives/DocumentGeometry.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace Mesh
+{
+  using iga_geometry_t = Document::DocumentGeometry::iga_geometry_t;
+
+  /**
+   * How surface vertices are stored in the GPU.
+   */
+  enum class VertexFormat {
+    /// Float position and float normal: 24 bytes.
+    FLOAT,
+    /**
+     * Position in signed normalized shorts (in a QuantizationFrame)
+     * and normal in signed normalized bytes: 12 bytes.
+     * The error is a 32767th of the frame, about the size of the geometry.
+     */
+    COMPACT,
+  };
+
+  /**
+   * How fine a geometry is tessellated.
+   */
+  struct TessellationParameters
+  {
+    /// Maximum distance between the geometry and its chords (model units).
+    real_t chordalTolerance = 1e-2;
+    /// Limits to the number of segments in each knot span (each direction).
+    /// @{
+    int minSegmentsPerSpan = 1;
+    int maxSegmentsPerSpan = 256;
+    /// @}
+    /**
+     * Meshes are split in chunks addressable by 16-bit indices.
+     * When set, a mesh that does not fit is kept whole,
+     * with 32-bit indices instead.
+     */
+    bool wideIndexes = false;
+    /// Curves have no normals and are always stored as floats.
+    VertexFormat vertexFormat = VertexFormat::FLOAT;
+    /**
+     * Reorders the triangles and vertices of surfaces
+     * for the GPU's post-transform vertex cache.
+     * See optimize_vertex_cache().
+     */
+    bool optimizeVertexCache = false;
+    /// With optimizeVertexCache, also merges the duplicated vertices
+    /// of seams and poles.
+    bool weldSeams = false;
+    /**
+     * Analytic primitives (spheres and circles) are tessellated
+     * in closed form, instead of evaluating their NURBS,
+     * when their Document::AnalyticShape is known.
+     */
+    bool analyticShapes = true;
+
+    bool operator==(const TessellationParameters&) const = default;
+  };
+
+  /**
+   * Parameter values along @a direction where @a geometry is sampled.
+   *
+   * Each knot span is split uniformly.
+   * The number of segments is chosen so the chordal deviation,
+   * bounded by \f$h^2 \max|C''| / 8\f$ for a segment of length \f$h\f$,
+   * stays below the tolerance.
+   * The second derivative is probed at a few points in the span
+   * (and across the whole range of the other directions).
+   *
+   * Flat regions get a single segment per span,
+   * curved regions as many as needed.
+   *
+   * @returns Increasing values, including both ends of the parameter range.
+   */
+  std::vector<real_t>
+  adaptive_samples(const iga_geometry_t& geometry, short_t direction,
+                   const TessellationParameters& parameters);
+
+  /**
+   * Parameter values where the curve @a geometry is sampled.
+   *
+   * Like adaptive_samples(), but the samples of each knot span are
+   * evenly spaced in arc length, and their number comes from the
+   * geometric curvature \f$\kappa\f$ (a chord of length \f$s\f$
+   * deviates about \f$\kappa s^2 / 8\f$ from the curve).
+   * So the points of a rational circle, whose parametrization
+   * does not have constant speed, are evenly distributed along it,
+   * and short spans get few points.
+   * Length and curvature are probed at a few points in each span.
+   *
+   * @returns Increasing values, including both ends of the parameter range.
+   */
+  std::vector<real_t>
+  curve_samples(const iga_geometry_t& geometry, const TessellationParameters& parameters);
+
+  /**
+   * Douglas-Peucker simplification of the polyline
+   * of @a count points (3 floats each) at @a points.
+   *
+   * @returns The increasing indexes of the points kept,
+   * always including the first and the last.
+   * Every point dropped is within @a tolerance of the polyline kept.
+   */
+  std::vector<std::uint32_t>
+  simplify_polyline(const float* points, size_t count, real_t tolerance);
+
+  /**
+   * The tensor grid of @a samples,
+   * with the first direction varying faster.
+   */
+  gismo::gsMatrix<real_t>
+  grid_points(const std::vector<std::vector<real_t>>& samples);
+
+  /**
+   * Hash of everything that determines the shape of @a geometry:
+   * degrees, knots, weights (if rational) and coefficients.
+   *
+   * Equal geometries have equal hashes, even if they are different objects.
+   */
+  std::uint64_t geometry_hash(const iga_geometry_t& geometry);
+
+  /**
+   * Hash of @a shape, like geometry_hash().
+   */
+  std::uint64_t analytic_hash(const Document::AnalyticShape& shape);
+
+  /**
+   * Hash of everything that determines the basis functions of @a basis
+   * evaluated on the tensor grid of @a samples:
+   * degrees, knots and the samples themselves.
+   *
+   * Weights are not included: they are applied afterwards, like coefficients.
+   */
+  std::uint64_t grid_hash(const gismo::gsBasis<real_t>& basis,
+                          const std::vector<std::vector<real_t>>& samples);
+}
@@ -0,0 +1,155 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+#include "TessellationCache.h"
+
+#include <functional>
+
+using namespace Mesh;
+
+namespace {
+  void hash_combine(size_t& seed, size_t value)
+  {
+    seed ^= value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2);
+  }
+}
+
+size_t TessellationCache::KeyHash::operator()(const Key& key) const
+{
+  const auto& p = key.parameters;
+  size_t seed = std::hash<std::uint64_t>{}(key.geometry);
+  hash_combine(seed, std::hash<real_t>{}(p.chordalTolerance));
+  hash_combine(seed, std::hash<int>{}(p.minSegmentsPerSpan));
+  hash_combine(seed, std::hash<int>{}(p.maxSegmentsPerSpan));
+  hash_combine(seed, std::hash<bool>{}(p.wideIndexes));
+  hash_combine(seed, std::hash<VertexFormat>{}(p.vertexFormat));
+  hash_combine(seed, std::hash<bool>{}(p.optimizeVertexCache));
+  hash_combine(seed, std::hash<bool>{}(p.weldSeams));
+  hash_combine(seed, std::hash<bool>{}(p.analyticShapes));
+  return seed;
+}
+
+
+TessellationCache::TessellationCache(size_t capacity_bytes)
+    : tessellations(capacity_bytes)
+{}
+
+TessellationCache& TessellationCache::global()
+{
+  static TessellationCache cache;
+  return cache;
+}
+
+TessellationCache::tessellation_t TessellationCache::find(const Key& key)
+{
+  std::scoped_lock lock{mutex};
+  const auto* found = tessellations.find(key);
+  if(!found) {
+    ++misses;
+    return nullptr;
+  }
+  ++hits;
+  return *found;
+}
+
+TessellationCache::tessellation_t
+TessellationCache::tessellate(const iga_geometry_t& geometry,
+                              const TessellationParameters& parameters,
+                              const Threads::CancellationToken& cancel,
+                              const Document::AnalyticShape* shape,
+                              bool persistent)
+{
+  // Closed form tessellations depend only on the shape.
+  const bool analytic = shape && parameters.analyticShapes;
+  const Key key{analytic ? analytic_hash(*shape) : geometry_hash(geometry), parameters};
+  auto result = find(key);
+  if(result) {
+    return result;
+  }
+  const auto disk = getDiskCache();
+  if(disk) {
+    result = disk->load(key.geometry, parameters);
+    if(result) {
+      insert(key, result, result->byteSize());
+      return result;
+    }
+  }
+
+  auto tessellated = Mesh::tessellate(geometry, parameters, cancel, shape);
+  if(cancel.isCancelled()) {
+    return nullptr;
+  }
+  const auto bytes = tessellated.byteSize();
+  result = std::make_shared<const TessellationResult>(std::move(tessellated));
+  insert(key, result, bytes);
+  {
+    std::scoped_lock lock{mutex};
+    vertexCache += result->vertexCache;
+  }
+  if(disk && persistent) {
+    disk->storeLater(key.geometry, parameters, result);
+  }
+  return result;
+}
+
+void TessellationCache::insert(const Key& key, tessellation_t tessellation, size_t size)
+{
+  std::scoped_lock lock{mutex};
+  tessellations.insert(key, std::move(tessellation), size);
+}
+
+void TessellationCache::setCapacity(size_t capacity_bytes)
+{
+  std::scoped_lock lock{mutex};
+  tessellations.setCapacity(capacity_bytes);
+}
+
+size_t TessellationCache::getCapacity() const
+{
+  std::scoped_lock lock{mutex};
+  return tessellations.getCapacity();
+}
+
+void TessellationCache::setDiskCache(std::shared_ptr<TessellationDiskCache> disk_cache)
+{
+  std::scoped_lock lock{mutex};
+  diskCache = std::move(disk_cache);
+}
+
+std::shared_ptr<TessellationDiskCache> TessellationCache::getDiskCache() const
+{
+  std::scoped_lock lock{mutex};
+  return diskCache;
+}
+
+void TessellationCache::clear()
+{
+  std::scoped_lock lock{mutex};
+  tessellations.clear();
+}
+
+TessellationCache::Metrics TessellationCache::getMetrics() const
+{
+  std::scoped_lock lock{mutex};
+  return {.hits = hits, .misses = misses, .evictions = tessellations.getEvictions(),
+          .entries = tessellations.size(), .bytes = tessellations.getBytes(),
+          .capacity = tessellations.getCapacity(), .vertexCache = vertexCache};
+}
@@ -0,0 +1,151 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+#pragma once
+
+#include "LruIndex.h"
+#include "Tessellation.h"
+#include "TessellationDiskCache.h"
+#include "TessellationResult.h"
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+
+namespace Mesh
+{
+  /**
+   * Tessellations shared by every mesh of the same shape.
+   *
+   * Two spheres with the same center and radius, for instance,
+   * are tessellated once. Entries are keyed by geometry_hash()
+   * and the TessellationParameters, so the cache does not keep
+   * the geometries alive.
+   *
+   * The least recently used tessellations are dropped when the
+   * cache grows beyond its capacity. Meshes that use them keep them
+   * alive anyway; they are only not shared with newcomers.
+   *
+   * Misses can be looked up in a TessellationDiskCache (see setDiskCache()),
+   * so reopening a document reads the tessellations instead of computing them.
+   *
+   * @attention
+   * Two meshes that miss at the same time both tessellate.
+   */
+  class TessellationCache
+  {
+  public:
+    using tessellation_t = std::shared_ptr<const TessellationResult>;
+
+    struct Key
+    {
+      std::uint64_t          geometry = 0;
+      TessellationParameters parameters;
+
+      bool operator==(const Key&) const = default;
+    };
+
+    struct Metrics
+    {
+      std::uint64_t hits = 0;
+      std::uint64_t misses = 0;
+      std::uint64_t evictions = 0;
+      size_t        entries = 0;
+      size_t        bytes = 0;
+      size_t        capacity = 0;
+      /// Summed over the surfaces tessellated (those missing in both caches).
+      VertexCacheStats vertexCache;
+    };
+
+    static constexpr size_t default_capacity = 256 * 1024 * 1024;
+
+    explicit TessellationCache(size_t capacity_bytes = default_capacity);
+
+    /**
+     * The cache used by every OgreGismoMesh.
+     */
+    static TessellationCache& global();
+
+    /**
+     * The tessellation for @a key, if cached (a hit), or nullptr (a miss).
+     */
+    tessellation_t find(const Key& key);
+
+    /**
+     * The tessellation of @a geometry with @a parameters:
+     * cached (in memory, or in the disk cache),
+     * or tessellated and inserted (in both).
+     * Returns nullptr if @a cancel is cancelled meanwhile.
+     *
+     * If the exact @a shape of @a geometry is given,
+     * see Mesh::tessellate().
+     *
+     * Unless @a persistent is false (for geometries being edited,
+     * which are unlikely to be reopened as they are),
+     * what it tessellates is queued for the disk cache
+     * (see TessellationDiskCache::storeLater()).
+     */
+    tessellation_t tessellate(const iga_geometry_t& geometry,
+                              const TessellationParameters& parameters,
+                              const Threads::CancellationToken& cancel = {},
+                              const Document::AnalyticShape* shape = nullptr,
+                              bool persistent = true);
+
+    /**
+     * Caches @a tessellation, which takes @a bytes.
+     * Replaces the previous tessellation for the same key, if any.
+     */
+    void insert(const Key& key, tessellation_t tessellation, size_t bytes);
+
+    void   setCapacity(size_t capacity_bytes);
+    size_t getCapacity() const;
+
+    /**
+     * Where tessellate() looks for what is not in memory,
+     * and stores what it tessellates. Null (the default) for none.
+     */
+    /// @{
+    void setDiskCache(std::shared_ptr<TessellationDiskCache> disk_cache);
+    std::shared_ptr<TessellationDiskCache> getDiskCache() const;
+    /// @}
+
+    void clear();
+
+    Metrics getMetrics() const;
+
+  private:
+    struct KeyHash
+    {
+      size_t operator()(const Key& key) const;
+    };
+
+    mutable std::mutex mutex;
+    /// Protected by `mutex`.
+    LruIndex<Key, tessellation_t, KeyHash> tessellations;
+
+    /// Protected by `mutex`.
+    std::shared_ptr<TessellationDiskCache> diskCache;
+
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    VertexCacheStats vertexCache;
+  };
+}
@@ -0,0 +1,526 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "TessellationDiskCache.h"
+
+#include <libparacadis/base/threads/thread_pool/ThreadPool.h>
+
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <string>
+#include <system_error>
+#include <vector>
+
+using namespace Mesh;
+namespace fs = std::filesystem;
+
+namespace {
+  /// "PCTC". A machine of the other byte order reads it swapped.
+  constexpr std::uint32_t magic = 0x43544350;
+  constexpr const char* extension = ".tess";
+  /// Temporary files older than this were left by a process that died.
+  constexpr std::chrono::hours stale_temporary{1};
+
+  /**
+   * What identifies a tessellation: stored in the header of its file,
+   * and hashed into the file name.
+   */
+  struct key_t
+  {
+    std::uint64_t geometry;
+    double        chordalTolerance;
+    std::int32_t  minSegmentsPerSpan;
+    std::int32_t  maxSegmentsPerSpan;
+    std::uint8_t  wideIndexes;
+    std::uint8_t  vertexFormat;
+    std::uint8_t  optimizeVertexCache;
+    std::uint8_t  weldSeams;
+    std::uint8_t  analyticShapes;
+    std::uint8_t  padding[3];
+
+    bool operator==(const key_t&) const = default;
+  };
+  static_assert(sizeof(key_t) == 32);
+
+  struct header_t
+  {
+    std::uint32_t magic;
+    std::uint32_t version;
+    key_t         key;
+    std::int32_t  dimension;
+    std::uint32_t lineList;
+    std::uint64_t chunks;
+    /// VertexCacheStats
+    std::uint64_t vertexCache[5];
+    /// QuantizationFrame: the offset, and the scale.
+    float         frame[4];
+  };
+  static_assert(sizeof(header_t) == 112);
+
+  /// Followed by the blobs, in this order.
+  struct chunk_header_t
+  {
+    std::uint64_t vertex;
+    std::uint64_t compactVertex;
+    std::uint64_t indexes;
+    std::uint64_t wideIndexes;
+    std::uint64_t blockHashes;
+    std::uint64_t indexHash;
+    float         min_bound[3];
+    float         max_bound[3];
+  };
+  static_assert(sizeof(chunk_header_t) == 72);
+
+  key_t make_key(std::uint64_t geometry, const TessellationParameters& parameters)
+  {
+    // Value initialized: the padding is zero, and hashes the same every time.
+    key_t key{};
+    key.geometry = geometry;
+    key.chordalTolerance = parameters.chordalTolerance;
+    key.minSegmentsPerSpan = parameters.minSegmentsPerSpan;
+    key.maxSegmentsPerSpan = parameters.maxSegmentsPerSpan;
+    key.wideIndexes = parameters.wideIndexes;
+    key.vertexFormat = std::uint8_t(parameters.vertexFormat);
+    key.optimizeVertexCache = parameters.optimizeVertexCache;
+    key.weldSeams = parameters.weldSeams;
+    key.analyticShapes = parameters.analyticShapes;
+    return key;
+  }
+
+  /**
+   * 64-bit FNV-1a of @a key.
+   * Unlike std::hash, it is the same in every run.
+   */
+  std::uint64_t file_name(const key_t& key)
+  {
+    std::uint64_t value = 14695981039346656037ull;
+    const auto* bytes = reinterpret_cast<const unsigned char*>(&key);
+    for(size_t i = 0; i < sizeof(key); ++i) {
+      value = (value ^ bytes[i]) * 1099511628211ull;
+    }
+    return value;
+  }
+
+  /**
+   * The name of a cache file, or false for any other file.
+   */
+  bool parse_name(const fs::path& file, std::uint64_t& name)
+  {
+    if(file.extension() != extension) {
+      return false;
+    }
+    const auto stem = file.stem().string();
+    const auto [end, error] = std::from_chars(stem.data(), stem.data() + stem.size(), name, 16);
+    return error == std::errc{} && end == stem.data() + stem.size() && stem.size() == 16;
+  }
+
+  template<typename T>
+  void write_blob(std::ostream& out, const std::vector<T>& blob)
+  {
+    out.write(reinterpret_cast<const char*>(blob.data()), sizeof(T) * blob.size());
+  }
+
+  void write_tessellation(std::ostream& out, const key_t& key, const TessellationResult& tessellation)
+  {
+    const auto& stats = tessellation.vertexCache;
+    const header_t header{
+        .magic = magic,
+        .version = TessellationDiskCache::format_version,
+        .key = key,
+        .dimension = tessellation.dimension,
+        .lineList = tessellation.lineList,
+        .chunks = tessellation.chunks.size(),
+        .vertexCache = {stats.trianglesBefore, stats.trianglesAfter,
+                        stats.missesBefore, stats.missesAfter, stats.welded},
+        .frame = {tessellation.frame.offset[0], tessellation.frame.offset[1],
+                  tessellation.frame.offset[2], tessellation.frame.scale}};
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    for(const auto& chunk: tessellation.chunks) {
+      chunk_header_t chunk_header{
+          .vertex = chunk.vertex.size(),
+          .compactVertex = chunk.compactVertex.size(),
+          .indexes = chunk.indexes.size(),
+          .wideIndexes = chunk.wideIndexes.size(),
+          .blockHashes = chunk.blockHashes.size(),
+          .indexHash = chunk.indexHash,
+          .min_bound = {},
+          .max_bound = {}};
+      std::copy_n(chunk.min_bound.begin(), 3, chunk_header.min_bound);
+      std::copy_n(chunk.max_bound.begin(), 3, chunk_header.max_bound);
+      out.write(reinterpret_cast<const char*>(&chunk_header), sizeof(chunk_header));
+
+      write_blob(out, chunk.vertex);
+      write_blob(out, chunk.compactVertex);
+      write_blob(out, chunk.indexes);
+      write_blob(out, chunk.wideIndexes);
+      write_blob(out, chunk.blockHashes);
+    }
+  }
+
+  /**
+   * Reads @a count elements into @a blob,
+   * unless they would go beyond the @a remaining bytes of the file.
+   */
+  template<typename T>
+  bool read_blob(std::istream& in, std::vector<T>& blob, std::uint64_t count,
+                 std::uint64_t& remaining)
+  {
+    if(count > remaining / sizeof(T)) {
+      return false;
+    }
+    blob.resize(count);
+    in.read(reinterpret_cast<char*>(blob.data()), sizeof(T) * count);
+    remaining -= sizeof(T) * count;
+    return bool(in);
+  }
+
+  template<typename T>
+  bool read_struct(std::istream& in, T& value, std::uint64_t& remaining)
+  {
+    if(sizeof(T) > remaining) {
+      return false;
+    }
+    in.read(reinterpret_cast<char*>(&value), sizeof(T));
+    remaining -= sizeof(T);
+    return bool(in);
+  }
+
+  /**
+   * The tessellation in @a in, of @a size bytes, if it is stored for @a key
+   * in this version, and complete. Otherwise, nullptr.
+   */
+  std::shared_ptr<TessellationResult>
+  read_tessellation(std::istream& in, const key_t& key, std::uint64_t size)
+  {
+    header_t header;
+    if(!read_struct(in, header, size)
+       || header.magic != magic || header.version != TessellationDiskCache::format_version
+       || header.key != key || (header.dimension != 1 && header.dimension != 2)
+       || header.chunks > size / sizeof(chunk_header_t)) {
+      return nullptr;
+    }
+
+    auto result = std::make_shared<TessellationResult>();
+    result->dimension = header.dimension;
+    result->lineList = header.lineList;
+    auto& stats = result->vertexCache;
+    stats.trianglesBefore = header.vertexCache[0];
+    stats.trianglesAfter = header.vertexCache[1];
+    stats.missesBefore = header.vertexCache[2];
+    stats.missesAfter = header.vertexCache[3];
+    stats.welded = header.vertexCache[4];
+    std::copy_n(header.frame, 3, result->frame.offset.begin());
+    result->frame.scale = header.frame[3];
+
+    result->chunks.resize(header.chunks);
+    for(auto& chunk: result->chunks) {
+      chunk_header_t chunk_header;
+      if(!read_struct(in, chunk_header, size)
+         || !read_blob(in, chunk.vertex, chunk_header.vertex, size)
+         || !read_blob(in, chunk.compactVertex, chunk_header.compactVertex, size)
+         || !read_blob(in, chunk.indexes, chunk_header.indexes, size)
+         || !read_blob(in, chunk.wideIndexes, chunk_header.wideIndexes, size)
+         || !read_blob(in, chunk.blockHashes, chunk_header.blockHashes, size)) {
+        return nullptr;
+      }
+      std::copy_n(chunk_header.min_bound, 3, chunk.min_bound.begin());
+      std::copy_n(chunk_header.max_bound, 3, chunk.max_bound.begin());
+      chunk.indexHash = chunk_header.indexHash;
+    }
+    // Anything else is damage.
+    return (size == 0) ? result : nullptr;
+  }
+
+  /**
+   * A suffix no other thread, and most likely no other process, uses.
+   */
+  std::string temporary_suffix()
+  {
+    static const std::uint64_t session = (std::uint64_t(std::random_device{}()) << 32)
+                                         | std::random_device{}();
+    static std::atomic<std::uint64_t> counter = 0;
+    return std::format(".{:016x}-{}.tmp", session, counter++);
+  }
+}
+
+
+TessellationDiskCache::TessellationDiskCache(fs::path directory_path, size_t capacity_bytes)
+    : directory(std::move(directory_path))
+    , files(capacity_bytes)
+{
+  std::error_code error;
+  fs::create_directories(directory, error);
+
+  struct found_t
+  {
+    std::uint64_t        name;
+    size_t               bytes;
+    fs::file_time_type   time;
+  };
+  std::vector<found_t> found;
+  const auto now = fs::file_time_type::clock::now();
+  for(const auto& file: fs::directory_iterator(directory, error)) {
+    std::error_code file_error;
+    if(!file.is_regular_file(file_error)) {
+      continue;
+    }
+    const auto time = file.last_write_time(file_error);
+    if(file.path().extension() == ".tmp") {
+      if(!file_error && now - time > stale_temporary) {
+        fs::remove(file.path(), file_error);
+      }
+      continue;
+    }
+    std::uint64_t name;
+    if(!parse_name(file.path(), name)) {
+      continue;
+    }
+    const auto size = file.file_size(file_error);
+    if(!file_error) {
+      found.push_back({name, size, time});
+    }
+  }
+
+  // The most recently used, last.
+  std::ranges::sort(found, {}, &found_t::time);
+  std::vector<std::uint64_t> evicted;
+  {
+    std::scoped_lock lock{mutex};
+    for(const auto& file: found) {
+      std::ranges::move(files.insert(file.name, {}, file.bytes), std::back_inserter(evicted));
+    }
+  }
+  removeFiles(evicted);
+}
+
+TessellationDiskCache::~TessellationDiskCache()
+{
+  flush();
+}
+
+fs::path TessellationDiskCache::path(std::uint64_t name) const
+{
+  return directory / std::format("{:016x}{}", name, extension);
+}
+
+std::shared_ptr<const TessellationResult>
+TessellationDiskCache::load(std::uint64_t geometry, const TessellationParameters& parameters)
+{
+  const auto key = make_key(geometry, parameters);
+  const auto name = file_name(key);
+  const auto file = path(name);
+
+  // Another process might have stored it: the file system is what counts.
+  std::error_code error;
+  const auto size = fs::file_size(file, error);
+  std::ifstream in;
+  if(!error) {
+    in.open(file, std::ios::binary);
+  }
+  if(error || !in) {
+    std::scoped_lock lock{mutex};
+    ++misses;
+    return nullptr;
+  }
+
+  auto result = read_tessellation(in, key, size);
+  in.close();
+
+  if(!result) {
+    {
+      std::scoped_lock lock{mutex};
+      ++misses;
+      ++invalidated;
+      files.erase(name);
+    }
+    removeFiles({name});
+    return nullptr;
+  }
+  // Recently used, also for the next sessions.
+  fs::last_write_time(file, fs::file_time_type::clock::now(), error);
+
+  std::vector<std::uint64_t> evicted;
+  {
+    std::scoped_lock lock{mutex};
+    ++hits;
+    if(!files.find(name)) {
+      evicted = files.insert(name, {}, size);
+    }
+  }
+  removeFiles(evicted);
+  return result;
+}
+
+void TessellationDiskCache::store(std::uint64_t geometry, const TessellationParameters& parameters,
+                                  const TessellationResult& tessellation)
+{
+  const auto key = make_key(geometry, parameters);
+  const auto name = file_name(key);
+  const auto file = path(name);
+  auto temporary = file;
+  temporary += temporary_suffix();
+
+  std::error_code error;
+  {
+    std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+    write_tessellation(out, key, tessellation);
+    out.close();
+    if(!out) {
+      fs::remove(temporary, error);
+      return;
+    }
+  }
+  const auto size = fs::file_size(temporary, error);
+  if(!error) {
+    fs::rename(temporary, file, error);
+  }
+  if(error) {
+    fs::remove(temporary, error);
+    return;
+  }
+
+  std::vector<std::uint64_t> evicted;
+  {
+    std::scoped_lock lock{mutex};
+    ++stores;
+    evicted = files.insert(name, {}, size);
+  }
+  removeFiles(evicted);
+}
+
+void TessellationDiskCache::storeLater(std::uint64_t geometry,
+                                       const TessellationParameters& parameters,
+                                       std::shared_ptr<const TessellationResult> tessellation)
+{
+  const auto name = file_name(make_key(geometry, parameters));
+  {
+    std::scoped_lock lock{mutex};
+    queued[name] = {geometry, parameters, std::move(tessellation)};
+    lastQueued = std::chrono::steady_clock::now();
+    if(flushScheduled) {
+      return;
+    }
+    flushScheduled = true;
+  }
+  scheduleFlush(store_delay);
+}
+
+void TessellationDiskCache::flush()
+{
+  while(true) {
+    queued_t next;
+    {
+      std::scoped_lock lock{mutex};
+      if(queued.empty()) {
+        return;
+      }
+      next = std::move(queued.extract(queued.begin()).mapped());
+    }
+    store(next.geometry, next.parameters, *next.tessellation);
+  }
+}
+
+void TessellationDiskCache::scheduleFlush(std::chrono::steady_clock::duration delay)
+{
+  Threads::ThreadPool::global().submitAfter(delay, [weak_self = weak_from_this()] {
+    auto self = weak_self.lock();
+    if(self) {
+      self->flushWhenIdle();
+    }
+  });
+}
+
+void TessellationDiskCache::flushWhenIdle()
+{
+  std::chrono::steady_clock::duration idle;
+  {
+    std::scoped_lock lock{mutex};
+    idle = std::chrono::steady_clock::now() - lastQueued;
+    if(idle >= store_delay) {
+      flushScheduled = false;
+    }
+  }
+  if(idle < store_delay) {
+    // Still busy tessellating: wait until it calms down.
+    scheduleFlush(store_delay - idle);
+    return;
+  }
+  flush();
+}
+
+void TessellationDiskCache::setCapacity(size_t capacity_bytes)
+{
+  std::vector<std::uint64_t> evicted;
+  {
+    std::scoped_lock lock{mutex};
+    evicted = files.setCapacity(capacity_bytes);
+  }
+  removeFiles(evicted);
+}
+
+size_t TessellationDiskCache::getCapacity() const
+{
+  std::scoped_lock lock{mutex};
+  return files.getCapacity();
+}
+
+void TessellationDiskCache::clear()
+{
+  {
+    std::scoped_lock lock{mutex};
+    queued.clear();
+    files.clear();
+  }
+  std::error_code error;
+  // Also the files stored by other processes.
+  for(const auto& file: fs::directory_iterator(directory, error)) {
+    std::uint64_t name;
+    if(parse_name(file.path(), name)) {
+      std::error_code file_error;
+      fs::remove(file.path(), file_error);
+    }
+  }
+}
+
+TessellationDiskCache::Metrics TessellationDiskCache::getMetrics() const
+{
+  std::scoped_lock lock{mutex};
+  return {.hits = hits, .misses = misses, .stores = stores,
+          .evictions = files.getEvictions(), .invalidated = invalidated,
+          .queued = queued.size(), .files = files.size(), .bytes = files.getBytes(),
+          .capacity = files.getCapacity()};
+}
+
+void TessellationDiskCache::removeFiles(const std::vector<std::uint64_t>& names) const
+{
+  for(const auto name: names) {
+    std::error_code error;
+    fs::remove(path(name), error);
+  }
+}
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "LruIndex.h"
+#include "Tessellation.h"
+#include "TessellationResult.h"
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace Mesh
+{
+  /**
+   * Tessellations kept in files, so reopening a document
+   * does not tessellate everything again.
+   *
+   * It is the second level of the TessellationCache (see
+   * TessellationCache::setDiskCache()), keyed the same way:
+   * by geometry_hash() (or analytic_hash()) and the TessellationParameters.
+   * Each tessellation is a file in the cache directory.
+   *
+   * Chunks are stored as they are uploaded: vertices (in the
+   * TessellationParameters::vertexFormat), indexes and their hashes,
+   * each one a contiguous blob read straight into the MeshChunk.
+   * Loading is I/O, with no decoding and no math.
+   *
+   * Files of another `format_version`, or damaged, are misses,
+   * and are removed. Files are written to a temporary name and then
+   * renamed, so nobody (another thread, or another process) reads
+   * a partial file.
+   *
+   * The least recently used files are removed when the directory
+   * grows beyond its capacity.
+   * Errors (a read-only directory, a full disk) only make it miss:
+   * nothing here throws.
+   *
+   * No file is read, written or removed holding the mutex,
+   * so a slow disk only delays the thread doing the I/O.
+   */
+  class TessellationDiskCache
+      : public std::enable_shared_from_this<TessellationDiskCache>
+  {
+  public:
+    /**
+     * Bump it whenever the file layout
+     * or what tessellate() produces changes.
+     */
+    static constexpr std::uint32_t format_version = 2;
+
+    static constexpr size_t default_capacity = 1024 * 1024 * 1024;
+    /// storeLater() writes once nothing was queued for this long.
+    static constexpr std::chrono::seconds store_delay{2};
+
+    struct Metrics
+    {
+      std::uint64_t hits = 0;
+      std::uint64_t misses = 0;
+      std::uint64_t stores = 0;
+      std::uint64_t evictions = 0;
+      /// Files removed because of their version, or damaged.
+      std::uint64_t invalidated = 0;
+      /// Waiting to be stored (see storeLater()).
+      size_t        queued = 0;
+      size_t        files = 0;
+      size_t        bytes = 0;
+      size_t        capacity = 0;
+    };
+
+    /**
+     * Uses (and creates, if needed) @a directory.
+     * Files already there are kept, from the least recently used.
+     */
+    explicit TessellationDiskCache(std::filesystem::path directory,
+                                   size_t capacity_bytes = default_capacity);
+    /// Stores what is still queued.
+    ~TessellationDiskCache();
+
+    const std::filesystem::path& getDirectory() const { return directory; }
+
+    /**
+     * The tessellation of the geometry of hash @a geometry
+     * with @a parameters, if stored (a hit), or nullptr (a miss).
+     */
+    std::shared_ptr<const TessellationResult>
+    load(std::uint64_t geometry, const TessellationParameters& parameters);
+
+    /**
+     * Stores @a tessellation, replacing the file for the same key, if any.
+     */
+    void store(std::uint64_t geometry, const TessellationParameters& parameters,
+               const TessellationResult& tessellation);
+    /**
+     * Queues @a tessellation, to be stored in the thread pool
+     * once nothing was queued for `store_delay`:
+     * tessellating is never slowed down by writing files.
+     * A newer tessellation for the same key replaces the queued one.
+     *
+     * @attention The cache must be owned by a std::shared_ptr.
+     */
+    void storeLater(std::uint64_t geometry, const TessellationParameters& parameters,
+                    std::shared_ptr<const TessellationResult> tessellation);
+    /**
+     * Stores everything queued, now.
+     */
+    void flush();
+
+    void   setCapacity(size_t capacity_bytes);
+    size_t getCapacity() const;
+
+    /**
+     * Removes every file of the cache.
+     */
+    void clear();
+
+    Metrics getMetrics() const;
+
+  private:
+    const std::filesystem::path directory;
+
+    struct queued_t
+    {
+      std::uint64_t                             geometry;
+      TessellationParameters                    parameters;
+      std::shared_ptr<const TessellationResult> tessellation;
+    };
+
+    mutable std::mutex mutex;
+    /// The files (by name) and their sizes. Protected by `mutex`.
+    LruIndex<std::uint64_t, std::monostate> files;
+
+    /// By file name. Protected by `mutex`.
+    std::unordered_map<std::uint64_t, queued_t> queued;
+    /// Protected by `mutex`.
+    std::chrono::steady_clock::time_point lastQueued;
+    /// A flush is submitted to the thread pool. Protected by `mutex`.
+    bool flushScheduled = false;
+
+    std::uint64_t hits = 0;
+    std::uint64_t misses = 0;
+    std::uint64_t stores = 0;
+    std::uint64_t invalidated = 0;
+
+    std::filesystem::path path(std::uint64_t name) const;
+    /**
+     * Removes the files evicted from `files`.
+     * @attention Call it without holding `mutex`.
+     */
+    void removeFiles(const std::vector<std::uint64_t>& names) const;
+
+    void scheduleFlush(std::chrono::steady_clock::duration delay);
+    /// Flushes, unless something was queued in the last `store_delay`.
+    void flushWhenIdle();
+  };
+}
@@ -0,0 +1,663 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "TessellationResult.h"
+
+#include "AnalyticTessellation.h"
+#include "GridEvaluator.h"
+#include "VertexCacheOptimizer.h"
+#include "VertexPacking.h"
+
+#include <gismo/gismo.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace Mesh;
+
+namespace {
+  /**
+   * Number of parameter points evaluated by each task, approximately.
+   * Small tiles do not pay for the evaluation setup,
+   * and we want a few tiles per worker for load balancing.
+   */
+  /// @{
+  constexpr index_t min_points_per_tile = 256;
+  constexpr index_t max_points_per_tile = 4096;
+  constexpr index_t tiles_per_worker = 4;
+  /// @}
+
+  /**
+   * Sets the chunk's bounds from its vertex positions.
+   */
+  void set_bounds(MeshChunk& chunk, size_t entries_per_point)
+  {
+    chunk.min_bound.fill(std::numeric_limits<float>::max());
+    chunk.max_bound.fill(-std::numeric_limits<float>::max());
+    reduce_bounds(chunk.vertex.data(), chunk.vertex.size() / entries_per_point,
+                  entries_per_point, chunk.min_bound, chunk.max_bound);
+  }
+
+  /**
+   * Triangle list for a grid of `cols` by `rows` vertices (`cols` varies faster).
+   *
+   * Triangles are counter-clockwise with respect to the normal field
+   * (\f$\partial_u \times \partial_v\f$).
+   * Each triangle is emitted once: back faces are rendered
+   * by a material that does not cull them.
+   */
+  template<typename Index>
+  void grid_triangles(index_t cols, index_t rows, std::vector<Index>& triangles)
+  {
+    triangles.reserve(2 * 3 * (cols-1) * (rows-1));
+    for(index_t j = 0; j < rows-1; ++j) {
+      for(index_t i= 0; i < cols-1; ++i) {
+        const Index ind1 = j * cols + i;
+        const Index ind2 = ind1 + cols;
+        triangles.push_back(ind1);
+        triangles.push_back(ind1+1);
+        triangles.push_back(ind2+1);
+
+        triangles.push_back(ind2+1);
+        triangles.push_back(ind2);
+        triangles.push_back(ind1);
+      }
+    }
+  }
+
+  /**
+   * A unit normal to signed normalized bytes (rounded to the nearest),
+   * followed by a zero.
+   */
+  void pack_normal(const float* normal, std::int8_t* out)
+  {
+#if defined(__SSE2__)
+    const __m128 scaled = _mm_mul_ps(_mm_set_ps(0, normal[2], normal[1], normal[0]),
+                                     _mm_set1_ps(127));
+    const __m128i words = _mm_cvtps_epi32(scaled);
+    const __m128i shorts = _mm_packs_epi32(words, words);
+    const __m128i bytes = _mm_packs_epi16(shorts, shorts);
+    const int packed = _mm_cvtsi128_si32(bytes);
+    std::memcpy(out, &packed, 4);
+#else
+    for(int k = 0; k < 3; ++k) {
+      out[k] = static_cast<std::int8_t>(std::clamp(std::lround(127 * normal[k]), -127l, 127l));
+    }
+    out[3] = 0;
+#endif
+  }
+
+  /**
+   * A position to signed normalized shorts in @a frame (rounded to the nearest),
+   * followed by 32767, the normalized \f$w = 1\f$.
+   */
+  void pack_position(const float* position, const QuantizationFrame& frame,
+                     std::int16_t* out)
+  {
+    const float factor = 32767 / frame.scale;
+    for(int k = 0; k < 3; ++k) {
+      const long q = std::lround(factor * (position[k] - frame.offset[k]));
+      out[k] = static_cast<std::int16_t>(std::clamp(q, -32767l, 32767l));
+    }
+    out[3] = 32767;
+  }
+
+  /**
+   * Encloses the control points of @a geometry, and thus the geometry:
+   * with positive weights, it is in their convex hull.
+   */
+  QuantizationFrame control_points_frame(const iga_geometry_t& geometry)
+  {
+    const auto& coefs = geometry.coefs();
+    std::array<float, 3> min_bound{0, 0, 0};
+    std::array<float, 3> max_bound{0, 0, 0};
+    for(index_t d = 0; d < std::min<index_t>(3, coefs.cols()); ++d) {
+      min_bound[d] = coefs.col(d).minCoeff();
+      max_bound[d] = coefs.col(d).maxCoeff();
+    }
+    return QuantizationFrame::enclosing(min_bound, max_bound);
+  }
+
+  /**
+   * A fast hash of @a size bytes (FNV-1a on 64-bit words).
+   */
+  std::uint64_t word_hash(const void* data, size_t size)
+  {
+    constexpr std::uint64_t prime = 1099511628211ull;
+    std::uint64_t value = 14695981039346656037ull ^ size;
+
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    size_t i = 0;
+    for(; i + sizeof(std::uint64_t) <= size; i += sizeof(std::uint64_t)) {
+      std::uint64_t word;
+      std::memcpy(&word, bytes + i, sizeof(word));
+      value = (value ^ word) * prime;
+    }
+    for(; i < size; ++i) {
+      value = (value ^ bytes[i]) * prime;
+    }
+    return value;
+  }
+
+  /**
+   * Splits the line strip of @a npoints points (3 floats each)
+   * at the beginning of @a points in chunks.
+   */
+  std::vector<MeshChunk> polyline_chunks(const std::vector<float>& points, index_t npoints,
+                                         const TessellationParameters& parameters)
+  {
+    // Positions only.
+    constexpr size_t entries = 3;
+
+    // Consecutive chunks share one point, so the strip is not broken.
+    const bool wide = parameters.wideIndexes && size_t(npoints) > MeshChunk::max_vertices;
+    const index_t per_chunk = wide ? npoints : index_t(MeshChunk::max_vertices);
+
+    std::vector<MeshChunk> local_chunks;
+    for(index_t first = 0; ; first += per_chunk - 1) {
+      const index_t last = std::min<index_t>(npoints - 1, first + per_chunk - 1);
+      const index_t count = last - first + 1;
+
+      auto& chunk = local_chunks.emplace_back();
+      const auto begin = points.begin() + entries * first;
+      chunk.vertex.assign(begin, begin + entries * count);
+      set_bounds(chunk, entries);
+
+      if(wide) {
+        chunk.wideIndexes.resize(count);
+        std::iota(chunk.wideIndexes.begin(), chunk.wideIndexes.end(), 0);
+      } else {
+        chunk.indexes.resize(count);
+        std::iota(chunk.indexes.begin(), chunk.indexes.end(), 0);
+      }
+      chunk.hash();
+
+      if(last == npoints - 1) {
+        break;
+      }
+    }
+    return local_chunks;
+  }
+
+  /**
+   * Curve points are also dropped where the curve is nearly straight,
+   * within this fraction of the chordal tolerance.
+   * It is small, because the chords already deviate from the curve.
+   */
+  constexpr real_t simplification_tolerance_ratio = 0.25;
+
+  std::vector<MeshChunk> tessellate_curve(const iga_geometry_t& geometry,
+                                          const TessellationParameters& parameters)
+  {
+    const auto samples = curve_samples(geometry, parameters);
+    const index_t nsamples = samples.size();
+    // Positions only.
+    constexpr size_t entries = 3;
+
+    auto domain_points = grid_points({samples});
+    gismo::gsMatrix<real_t> _positions  = geometry.eval(domain_points);
+    assert(_positions.cols() == nsamples
+           && "Wrong number of positions predicted.");
+    if(_positions.rows() < 3) {
+      // Planar curves get z = 0.
+      _positions.conservativeResize(3, nsamples);
+      _positions.bottomRows(3 - geometry.targetDim()).setZero();
+    }
+
+    std::vector<float> points(entries * nsamples);
+    pack_vertices(_positions.data(), nullptr, nsamples, points.data());
+    const auto kept = simplify_polyline(
+        points.data(), nsamples, simplification_tolerance_ratio * parameters.chordalTolerance);
+    for(size_t k = 0; k < kept.size(); ++k) {
+      std::copy_n(&points[entries * kept[k]], entries, &points[entries * k]);
+    }
+    return polyline_chunks(points, kept.size(), parameters);
+  }
+
+  /**
+   * Appends the segments of @a chunk (a line strip, or a line list)
+   * to @a out, with its vertices starting at @a base.
+   */
+  template<typename In, typename Out>
+  void append_segments(const std::vector<In>& in, bool line_list, size_t base,
+                       std::vector<Out>& out)
+  {
+    if(line_list) {
+      for(const auto index: in) {
+        out.push_back(base + index);
+      }
+      return;
+    }
+    for(size_t k = 0; k + 1 < in.size(); ++k) {
+      out.push_back(base + in[k]);
+      out.push_back(base + in[k+1]);
+    }
+  }
+
+  /**
+   * Splits the grid of @a np points in @a positions_normals
+   * (6 floats each, the first direction varying faster) in chunks,
+   * and triangulates them.
+   * Compact chunks have their positions in @a frame.
+   */
+  std::vector<MeshChunk> grid_chunks(const std::vector<float>& positions_normals,
+                                     const std::array<index_t, 2>& np,
+                                     const TessellationParameters& parameters,
+                                     const QuantizationFrame& frame,
+                                     VertexCacheStats& vertex_cache)
+  {
+    const auto npoints = np[0] * np[1];
+    // Positions and normals.
+    constexpr size_t entries = 6;
+
+    /*
+     * Chunks are rectangles of the grid that share their boundary
+     * with the neighbours. As square as possible,
+     * but with no more than MeshChunk::max_vertices vertices.
+     */
+    const index_t max_vertices = MeshChunk::max_vertices;
+    index_t cols = np[0];
+    index_t rows = np[1];
+    if(npoints > max_vertices && !parameters.wideIndexes) {
+      const index_t side = std::sqrt(max_vertices);
+      cols = std::min(np[0], std::max(side, max_vertices / np[1]));
+      rows = std::min(np[1], max_vertices / cols);
+    }
+    const bool wide = (cols * rows > max_vertices);
+
+    struct range_t { index_t first; index_t last; };
+    auto split = [](index_t n, index_t per_chunk) {
+      std::vector<range_t> result;
+      for(index_t first = 0; ; first += per_chunk - 1) {
+        const index_t last = std::min<index_t>(n - 1, first + per_chunk - 1);
+        result.push_back({first, last});
+        if(last == n - 1) {
+          return result;
+        }
+      }
+    };
+    const auto col_ranges = split(np[0], cols);
+    const auto row_ranges = split(np[1], rows);
+
+    // Chunks are copied (and optimized, and their bounds reduced) in parallel.
+    Threads::TaskGroup group;
+    std::vector<MeshChunk> local_chunks(col_ranges.size() * row_ranges.size());
+    std::vector<VertexCacheStats> chunk_stats(local_chunks.size());
+    for(size_t r = 0; r < row_ranges.size(); ++r) {
+      for(size_t c = 0; c < col_ranges.size(); ++c) {
+        group.run([&, r, c] {
+          const auto [c0, c1] = col_ranges[c];
+          const auto [r0, r1] = row_ranges[r];
+          const index_t chunk_cols = c1 - c0 + 1;
+          const index_t chunk_rows = r1 - r0 + 1;
+
+          auto& chunk = local_chunks[r * col_ranges.size() + c];
+          chunk.vertex.reserve(entries * chunk_cols * chunk_rows);
+          for(index_t j = r0; j <= r1; ++j) {
+            const auto begin = positions_normals.begin() + entries * (j * np[0] + c0);
+            chunk.vertex.insert(chunk.vertex.end(), begin, begin + entries * chunk_cols);
+          }
+          if(wide) {
+            grid_triangles(chunk_cols, chunk_rows, chunk.wideIndexes);
+          } else {
+            grid_triangles(chunk_cols, chunk_rows, chunk.indexes);
+          }
+          if(parameters.optimizeVertexCache) {
+            chunk_stats[r * col_ranges.size() + c]
+                = optimize_vertex_cache(chunk, entries, parameters.weldSeams);
+          }
+
+          set_bounds(chunk, entries);
+          if(parameters.vertexFormat == VertexFormat::COMPACT) {
+            chunk.compact(frame);
+          }
+          // After the indexes are set, so they are hashed as well.
+          chunk.hash();
+        });
+      }
+    }
+    group.wait();
+    for(const auto& stats: chunk_stats) {
+      vertex_cache += stats;
+    }
+    return local_chunks;
+  }
+
+  std::vector<MeshChunk> tessellate_surface(const iga_geometry_t& geometry,
+                                            const TessellationParameters& parameters,
+                                            const Threads::CancellationToken& cancel,
+                                            const QuantizationFrame& frame,
+                                            VertexCacheStats& vertex_cache)
+  {
+    const GridEvaluator evaluator{geometry, {adaptive_samples(geometry, 0, parameters),
+                                             adaptive_samples(geometry, 1, parameters)}};
+    const std::array<index_t, 2> np{evaluator.cols(), evaluator.rows()};
+    const auto npoints = np[0] * np[1];
+    // Positions and normals.
+    constexpr size_t entries = GridEvaluator::entries;
+
+    std::vector<float> positions_normals;
+    positions_normals.resize(entries * npoints);
+
+    /*
+     * The grid is split in tiles of whole rows (`i` varies faster).
+     * Each tile is evaluated in the thread pool and written
+     * directly into its slice of the interleaved buffer.
+     */
+    const index_t workers = Threads::ThreadPool::global().size();
+    const index_t min_rows = std::max<index_t>(1, min_points_per_tile / np[0]);
+    const index_t max_rows = std::max<index_t>(min_rows, max_points_per_tile / np[0]);
+    const index_t rows_per_tile = std::clamp<index_t>(np[1] / (tiles_per_worker * workers),
+                                                      min_rows, max_rows);
+    const index_t n_tiles = (np[1] + rows_per_tile - 1) / rows_per_tile;
+
+    Threads::TaskGroup group;
+    for(index_t tile = 0; tile < n_tiles; ++tile) {
+      group.run([&, tile] {
+        if(cancel.isCancelled()) {
+          return;
+        }
+        const index_t first_row = tile * rows_per_tile;
+        const index_t rows = std::min<index_t>(rows_per_tile, np[1] - first_row);
+        evaluator.evaluate(first_row, rows, positions_normals.data() + entries * first_row * np[0]);
+      });
+    }
+    group.wait();
+    if(cancel.isCancelled()) {
+      return {};
+    }
+
+    return grid_chunks(positions_normals, np, parameters, frame, vertex_cache);
+  }
+}
+
+
+size_t MeshChunk::byteSize() const
+{
+  return sizeof(float) * vertex.size()
+         + sizeof(CompactVertex) * compactVertex.size()
+         + sizeof(std::uint16_t) * indexes.size()
+         + sizeof(std::uint32_t) * wideIndexes.size();
+}
+
+QuantizationFrame QuantizationFrame::enclosing(const std::array<float, 3>& min_bound,
+                                               const std::array<float, 3>& max_bound)
+{
+  double half_extent = 0;
+  for(int d = 0; d < 3; ++d) {
+    half_extent = std::max(half_extent, (double(max_bound[d]) - min_bound[d]) / 2);
+  }
+
+  /*
+   * Snapping the center moves it by up to a sixteenth of the scale,
+   * and the scale is at least 1.25 times the half extent:
+   * the box is still inside.
+   */
+  QuantizationFrame result;
+  result.scale = (half_extent > 0) ? std::exp2(std::ceil(std::log2(1.25 * half_extent))) : 1;
+  const double step = result.scale / 8;
+  for(int d = 0; d < 3; ++d) {
+    const double center = (double(min_bound[d]) + max_bound[d]) / 2;
+    result.offset[d] = step * std::round(center / step);
+  }
+  return result;
+}
+
+
+void MeshChunk::compact(const QuantizationFrame& frame)
+{
+  // Positions and normals.
+  constexpr size_t entries = 6;
+  const size_t count = vertex.size() / entries;
+
+  compactVertex.resize(count);
+  const float* in = vertex.data();
+  for(auto& out: compactVertex) {
+    pack_position(in, frame, out.position);
+    pack_normal(in + 3, out.normal);
+    in += entries;
+  }
+  vertex = {};
+}
+
+void MeshChunk::hash()
+{
+  const auto* data = static_cast<const char*>(vertexData());
+  const size_t bytes = vertexBytes();
+
+  blockHashes.clear();
+  for(size_t offset = 0; offset < bytes; offset += hash_block_bytes) {
+    blockHashes.push_back(word_hash(data + offset, std::min(hash_block_bytes, bytes - offset)));
+  }
+  indexHash = isWide() ? word_hash(wideIndexes.data(), sizeof(std::uint32_t) * wideIndexes.size())
+                       : word_hash(indexes.data(), sizeof(std::uint16_t) * indexes.size());
+}
+
+const void* MeshChunk::vertexData() const
+{
+  return isCompact() ? (const void*)compactVertex.data() : (const void*)vertex.data();
+}
+
+size_t MeshChunk::vertexBytes() const
+{
+  return isCompact() ? sizeof(CompactVertex) * compactVertex.size()
+                     : sizeof(float) * vertex.size();
+}
+
+
+double VertexCacheStats::acmrBefore() const
+{
+  return trianglesBefore ? double(missesBefore) / trianglesBefore : 0;
+}
+
+double VertexCacheStats::acmrAfter() const
+{
+  return trianglesAfter ? double(missesAfter) / trianglesAfter : 0;
+}
+
+VertexCacheStats& VertexCacheStats::operator+=(const VertexCacheStats& other)
+{
+  trianglesBefore += other.trianglesBefore;
+  trianglesAfter += other.trianglesAfter;
+  missesBefore += other.missesBefore;
+  missesAfter += other.missesAfter;
+  welded += other.welded;
+  return *this;
+}
+
+
+TessellationResult
+Mesh::merge_curves(const std::vector<std::shared_ptr<const TessellationResult>>& curves)
+{
+  // Positions only.
+  constexpr size_t entries = 3;
+
+  TessellationResult result;
+  result.dimension = 1;
+  result.lineList = true;
+
+  MeshChunk* open = nullptr;
+  auto close = [&] {
+    if(open) {
+      open->hash();
+      open = nullptr;
+    }
+  };
+  auto extend_bounds = [](MeshChunk& to, const MeshChunk& from) {
+    for(int d = 0; d < 3; ++d) {
+      to.min_bound[d] = std::min(to.min_bound[d], from.min_bound[d]);
+      to.max_bound[d] = std::max(to.max_bound[d], from.max_bound[d]);
+    }
+  };
+
+  for(const auto& curve: curves) {
+    if(!curve) {
+      continue;
+    }
+    assert(curve->dimension == 1 && "Only curves can be merged.");
+    for(const auto& chunk: curve->chunks) {
+      const size_t count = chunk.vertex.size() / entries;
+      if(count == 0) {
+        continue;
+      }
+      if(chunk.isWide()) {
+        // Too large to share a chunk.
+        close();
+        auto& wide = result.chunks.emplace_back();
+        wide.vertex = chunk.vertex;
+        wide.min_bound = chunk.min_bound;
+        wide.max_bound = chunk.max_bound;
+        append_segments(chunk.wideIndexes, curve->lineList, 0, wide.wideIndexes);
+        wide.hash();
+        continue;
+      }
+      if(open && open->vertex.size() / entries + count > MeshChunk::max_vertices) {
+        close();
+      }
+      if(!open) {
+        open = &result.chunks.emplace_back();
+        open->min_bound.fill(std::numeric_limits<float>::max());
+        open->max_bound.fill(-std::numeric_limits<float>::max());
+      }
+      const size_t base = open->vertex.size() / entries;
+      open->vertex.insert(open->vertex.end(), chunk.vertex.begin(), chunk.vertex.end());
+      append_segments(chunk.indexes, curve->lineList, base, open->indexes);
+      extend_bounds(*open, chunk);
+    }
+  }
+  close();
+  return result;
+}
+
+
+size_t TessellationResult::vertexCount() const
+{
+  size_t count = 0;
+  for(const auto& chunk: chunks) {
+    count += chunk.isCompact() ? chunk.compactVertex.size()
+                               : chunk.vertex.size() / entriesPerPoint();
+  }
+  return count;
+}
+
+size_t TessellationResult::triangleCount() const
+{
+  if(dimension != 2) {
+    return 0;
+  }
+  size_t count = 0;
+  for(const auto& chunk: chunks) {
+    count += chunk.indexCount() / 3;
+  }
+  return count;
+}
+
+size_t TessellationResult::byteSize() const
+{
+  size_t bytes = 0;
+  for(const auto& chunk: chunks) {
+    bytes += chunk.byteSize();
+  }
+  return bytes;
+}
+
+
+TessellationResult Mesh::tessellate(const iga_geometry_t& geometry,
+                                    const TessellationParameters& parameters,
+                                    const Threads::CancellationToken& cancel,
+                                    const Document::AnalyticShape* shape)
+{
+  if(shape && parameters.analyticShapes) {
+    return tessellate(*shape, parameters);
+  }
+
+  TessellationResult result;
+  result.dimension = geometry.parDim();
+
+  if(result.dimension == 1) {
+    result.chunks = tessellate_curve(geometry, parameters);
+  } else if(result.dimension == 2) {
+    if(parameters.vertexFormat == VertexFormat::COMPACT) {
+      result.frame = control_points_frame(geometry);
+    }
+    result.chunks = tessellate_surface(geometry, parameters, cancel,
+                                       result.frame, result.vertexCache);
+  } else {
+    assert(false && "Must be a curve or a surface.");
+  }
+  return result;
+}
+
+TessellationResult Mesh::tessellate(const Document::AnalyticShape& shape,
+                                    const TessellationParameters& parameters)
+{
+  TessellationResult result;
+  if(const auto* sphere = std::get_if<Document::AnalyticSphere>(&shape)) {
+    result.dimension = 2;
+    if(parameters.vertexFormat == VertexFormat::COMPACT) {
+      // The bounds of its NURBS control points: the same frame.
+      std::array<float, 3> min_bound, max_bound;
+      for(int d = 0; d < 3; ++d) {
+        min_bound[d] = sphere->center[d] - sphere->radius;
+        max_bound[d] = sphere->center[d] + sphere->radius;
+      }
+      result.frame = QuantizationFrame::enclosing(min_bound, max_bound);
+    }
+    const auto grid = sphere_grid(*sphere, parameters);
+    result.chunks = grid_chunks(grid.positions_normals, grid.np, parameters,
+                                result.frame, result.vertexCache);
+  } else if(const auto* circle = std::get_if<Document::AnalyticCircle>(&shape)) {
+    result.dimension = 1;
+    const auto points = circle_points(*circle, parameters);
+    result.chunks = polyline_chunks(points, points.size() / 3, parameters);
+  }
+  return result;
+}
+
+std::vector<TessellationResult>
+Mesh::tessellate_all(const std::vector<std::shared_ptr<const iga_geometry_t>>& geometries,
+                     const TessellationParameters& parameters,
+                     const Threads::CancellationToken& cancel)
+{
+  std::vector<TessellationResult> results(geometries.size());
+
+  // Surfaces split in tiles themselves. Waiting for them inside a task is fine.
+  Threads::TaskGroup group;
+  for(size_t k = 0; k < geometries.size(); ++k) {
+    group.run([&, k] {
+      if(cancel.isCancelled() || !geometries[k]) {
+        return;
+      }
+      results[k] = tessellate(*geometries[k], parameters, cancel);
+    });
+  }
+  group.wait();
+  return results;
+}
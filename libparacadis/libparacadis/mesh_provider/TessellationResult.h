@@ -0,0 +1,231 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "Tessellation.h"
+
+#include <libparacadis/base/threads/thread_pool/TaskGroup.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+ * Nothing here depends on Ogre: tessellations can be computed
+ * (and tested, and benchmarked) on machines with no GPU.
+ * OgreGismoMesh uploads them.
+ */
+namespace Mesh
+{
+  /**
+   * Maps the positions of a surface in VertexFormat::COMPACT
+   * to \f$[-1, 1]^3\f$: a position is `offset + scale * q`,
+   * for the quantized (and normalized) `q`.
+   *
+   * The scale is uniform, so normals need no correction,
+   * and OgreGismoMesh puts the frame in the transform of the SceneNode
+   * of each entity of the mesh.
+   */
+  struct QuantizationFrame
+  {
+    std::array<float, 3> offset{0, 0, 0};
+    float                scale = 1;
+
+    /**
+     * A frame for the box from @a min_bound to @a max_bound.
+     *
+     * The scale is a power of two and the offset a multiple of an eighth of it,
+     * so every level of detail, and small edits, get the same frame
+     * (and the mesh needs no new transform).
+     */
+    static QuantizationFrame enclosing(const std::array<float, 3>& min_bound,
+                                       const std::array<float, 3>& max_bound);
+
+    bool operator==(const QuantizationFrame&) const = default;
+  };
+
+  /**
+   * A surface vertex in VertexFormat::COMPACT.
+   */
+  struct CompactVertex
+  {
+    /// Position in the QuantizationFrame times 32767, and 32767 (\f$w = 1\f$).
+    std::int16_t position[4];
+    /// Normal times 127, and a zero.
+    std::int8_t  normal[4];
+  };
+  static_assert(sizeof(CompactVertex) == 12);
+
+  /**
+   * A piece of a tessellation, small enough to be addressed by 16-bit indices
+   * (unless TessellationParameters::wideIndexes is set).
+   * OgreGismoMesh uploads each one as an Ogre::SubMesh
+   * with its own vertex and index buffers.
+   *
+   * Vertices are interleaved: the position, and for surfaces the unit normal.
+   * Curves are line strips, surfaces are triangle lists.
+   * Chunks share their boundary vertices with their neighbours.
+   */
+  struct MeshChunk
+  {
+    /// Largest number of vertices addressable by 16-bit indices.
+    static constexpr size_t max_vertices = 0xFFFF;
+
+    std::vector<float>         vertex;
+    /// Replaces `vertex` for surfaces in VertexFormat::COMPACT.
+    std::vector<CompactVertex> compactVertex;
+    std::vector<std::uint16_t> indexes;
+    /// Only used when the chunk does not fit 16-bit indices.
+    std::vector<std::uint32_t> wideIndexes;
+    /// In model space, even for compact chunks.
+    /// @{
+    std::array<float, 3>       min_bound;
+    std::array<float, 3>       max_bound;
+    /// @}
+
+    /// Vertex data is compared in blocks of this size, to upload only what changed.
+    static constexpr size_t hash_block_bytes = 16 * 1024;
+    /// Hashes of each block of the vertex data, and of the indexes.
+    /// @{
+    std::vector<std::uint64_t> blockHashes;
+    std::uint64_t              indexHash = 0;
+    /// @}
+
+    bool   isWide() const { return !wideIndexes.empty(); }
+    bool   isCompact() const { return !compactVertex.empty(); }
+    size_t indexCount() const { return isWide() ? wideIndexes.size() : indexes.size(); }
+    size_t byteSize() const;
+
+    /**
+     * Packs `vertex` (positions and normals) into `compactVertex`,
+     * with positions in @a frame, and releases `vertex`.
+     */
+    void compact(const QuantizationFrame& frame);
+
+    /**
+     * Sets blockHashes and indexHash. Call it when the chunk is complete.
+     */
+    void hash();
+
+    /// Vertex data, as uploaded.
+    /// @{
+    const void* vertexData() const;
+    size_t      vertexBytes() const;
+    /// @}
+  };
+
+  /**
+   * What optimize_vertex_cache() did to some chunks.
+   *
+   * The ACMR (average cache miss ratio) is the number of vertices
+   * transformed per triangle, with a FIFO post-transform cache.
+   * It is 3 with no cache at all, and approaches 0.5 for large regular grids.
+   */
+  struct VertexCacheStats
+  {
+    size_t trianglesBefore = 0;
+    size_t trianglesAfter = 0;
+    size_t missesBefore = 0;
+    size_t missesAfter = 0;
+    /// Vertices merged into a coincident one.
+    size_t welded = 0;
+
+    double acmrBefore() const;
+    double acmrAfter() const;
+
+    VertexCacheStats& operator+=(const VertexCacheStats& other);
+  };
+
+  /**
+   * The tessellation of a curve or of a surface.
+   */
+  struct TessellationResult
+  {
+    /// Parametric dimension: 1 for curves and 2 for surfaces.
+    short_t                dimension = 0;
+    std::vector<MeshChunk> chunks;
+    /// Only with TessellationParameters::optimizeVertexCache.
+    VertexCacheStats       vertexCache;
+    /**
+     * For curves, the indexes of each chunk are a line list (pairs of points)
+     * instead of a line strip. See merge_curves().
+     */
+    bool                   lineList = false;
+    /// Where the positions of compact chunks are. Identity otherwise.
+    QuantizationFrame      frame;
+
+    /// Floats per vertex in MeshChunk::vertex.
+    size_t entriesPerPoint() const { return (dimension == 1) ? 3 : 6; }
+    size_t vertexCount() const;
+    size_t triangleCount() const;
+    size_t byteSize() const;
+  };
+
+  /**
+   * Tessellates @a geometry (a curve or a surface).
+   *
+   * Surfaces are evaluated in tiles, in the Threads::ThreadPool.
+   * Returns an empty result if @a cancel is cancelled meanwhile.
+   *
+   * If @a shape, the exact shape of @a geometry, is given
+   * (and TessellationParameters::analyticShapes is set),
+   * it is tessellated in closed form instead.
+   */
+  TessellationResult tessellate(const iga_geometry_t& geometry,
+                                const TessellationParameters& parameters,
+                                const Threads::CancellationToken& cancel = {},
+                                const Document::AnalyticShape* shape = nullptr);
+
+  /**
+   * Tessellates the analytic primitive @a shape in closed form
+   * (see AnalyticTessellation.h), with no NURBS evaluation.
+   *
+   * The result has the same layout as the tessellation of its NURBS,
+   * but points are evenly distributed (by angle),
+   * and the normals of the poles are exact.
+   */
+  TessellationResult tessellate(const Document::AnalyticShape& shape,
+                                const TessellationParameters& parameters);
+
+  /**
+   * Merges the tessellations of many curves in a single line list,
+   * so they are drawn with a few draw calls, instead of one each.
+   *
+   * Curves are packed in chunks of up to MeshChunk::max_vertices vertices.
+   * A curve (chunk) with wide indexes gets a chunk of its own.
+   */
+  TessellationResult
+  merge_curves(const std::vector<std::shared_ptr<const TessellationResult>>& curves);
+
+  /**
+   * Tessellates every geometry of @a geometries in parallel.
+   *
+   * Meant for batch jobs, like tessellating a whole document.
+   * The results are in the same order as the geometries.
+   */
+  std::vector<TessellationResult>
+  tessellate_all(const std::vector<std::shared_ptr<const iga_geometry_t>>& geometries,
+                 const TessellationParameters& parameters,
+                 const Threads::CancellationToken& cancel = {});
+}
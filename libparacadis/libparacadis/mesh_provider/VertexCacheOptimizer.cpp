@@ -0,0 +1,413 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "VertexCacheOptimizer.h"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+
+using namespace Mesh;
+
+namespace {
+  /**
+   * Scoring from Tom Forsyth's "Linear-Speed Vertex Cache Optimisation".
+   */
+  /// @{
+  constexpr float cache_decay_power = 1.5f;
+  constexpr float last_triangle_score = 0.75f;
+  constexpr float valence_boost_scale = 2.0f;
+  constexpr float valence_boost_power = 0.5f;
+  /// @}
+  /// Valence scores are tabulated up to this number of triangles.
+  constexpr size_t max_tabulated_valence = 32;
+
+  /**
+   * Vertices are welded when their coordinates differ by less than this
+   * fraction of the chunk's bounding box diagonal...
+   */
+  constexpr float weld_relative_tolerance = 1e-6f;
+  /// ... and their unit normals, by less than about 2.5 degrees.
+  constexpr float weld_min_cosine = 0.999f;
+
+  constexpr std::uint32_t none = std::numeric_limits<std::uint32_t>::max();
+
+  struct score_tables_t
+  {
+    std::array<float, vertex_cache_size>     cache;
+    std::array<float, max_tabulated_valence> valence;
+  };
+
+  const score_tables_t& score_tables()
+  {
+    static const score_tables_t tables = [] {
+      score_tables_t result;
+      for(size_t k = 0; k < vertex_cache_size; ++k) {
+        // The last triangle's vertices score the same,
+        // so the next triangle does not depend on their order.
+        result.cache[k] = (k < 3) ? last_triangle_score
+                                  : std::pow(1 - float(k - 3) / (vertex_cache_size - 3),
+                                             cache_decay_power);
+      }
+      result.valence[0] = 0;
+      for(size_t k = 1; k < max_tabulated_valence; ++k) {
+        result.valence[k] = valence_boost_scale * std::pow(float(k), -valence_boost_power);
+      }
+      return result;
+    }();
+    return tables;
+  }
+
+  /**
+   * Vertices with few remaining triangles score higher,
+   * so lone triangles are not left behind.
+   */
+  float vertex_score(std::uint32_t cache_position, std::uint32_t remaining)
+  {
+    if(remaining == 0) {
+      return -1;
+    }
+    const auto& tables = score_tables();
+    float score = (cache_position == none) ? 0 : tables.cache[cache_position];
+    score += (remaining < max_tabulated_valence)
+                 ? tables.valence[remaining]
+                 : valence_boost_scale * std::pow(float(remaining), -valence_boost_power);
+    return score;
+  }
+
+  template<typename Index>
+  size_t fifo_misses(const std::vector<Index>& triangles, size_t cache_size)
+  {
+    const size_t vertex_count = triangles.empty()
+        ? 0 : size_t(*std::ranges::max_element(triangles)) + 1;
+    // A vertex is in the cache if fewer than `cache_size` misses happened since its own.
+    std::vector<size_t> inserted(vertex_count, 0);
+    size_t misses = 0;
+    for(const auto index: triangles) {
+      if(inserted[index] == 0 || misses - inserted[index] >= cache_size) {
+        ++misses;
+        inserted[index] = misses;
+      }
+    }
+    return misses;
+  }
+
+  using cell_t = std::array<std::int64_t, 3>;
+
+  struct cell_hash_t
+  {
+    size_t operator()(const cell_t& cell) const
+    {
+      size_t hash = 0;
+      for(const auto coordinate: cell) {
+        hash = (hash ^ std::hash<std::int64_t>{}(coordinate)) * 0x100000001b3ull;
+      }
+      return hash;
+    }
+  };
+
+  /**
+   * Merges coincident vertices and drops the triangles that collapse.
+   *
+   * Vertices are hashed in a grid of cells as large as the tolerance,
+   * and only compared to those in the same or a neighbouring cell.
+   */
+  template<typename Index>
+  size_t weld(MeshChunk& chunk, std::vector<Index>& triangles, size_t entries)
+  {
+    const size_t vertex_count = chunk.vertex.size() / entries;
+    const float* vertex = chunk.vertex.data();
+    auto position = [&](size_t v) { return vertex + entries * v; };
+
+    float diagonal2 = 0;
+    for(int d = 0; d < 3; ++d) {
+      float lowest = std::numeric_limits<float>::max();
+      float highest = -std::numeric_limits<float>::max();
+      for(size_t v = 0; v < vertex_count; ++v) {
+        lowest = std::min(lowest, position(v)[d]);
+        highest = std::max(highest, position(v)[d]);
+      }
+      diagonal2 += (highest - lowest) * (highest - lowest);
+    }
+    const float tolerance = weld_relative_tolerance * std::sqrt(diagonal2);
+
+    auto coincident = [&](size_t a, size_t b) {
+      const float* p = position(a);
+      const float* q = position(b);
+      for(int d = 0; d < 3; ++d) {
+        if(std::abs(p[d] - q[d]) > tolerance) {
+          return false;
+        }
+      }
+      if(entries < 6) {
+        return true;
+      }
+      const float* n = p + 3;
+      const float* m = q + 3;
+      const float dot = n[0] * m[0] + n[1] * m[1] + n[2] * m[2];
+      const bool n_zero = (n[0] == 0 && n[1] == 0 && n[2] == 0);
+      const bool m_zero = (m[0] == 0 && m[1] == 0 && m[2] == 0);
+      return (n_zero && m_zero) || dot >= weld_min_cosine;
+    };
+
+    // All the positions are equal if the tolerance is 0: any cell size will do.
+    const float cell_size = (tolerance > 0) ? tolerance : 1;
+    auto cell_of = [&](size_t v) {
+      cell_t cell;
+      for(int d = 0; d < 3; ++d) {
+        cell[d] = std::int64_t(std::floor(position(v)[d] / cell_size));
+      }
+      return cell;
+    };
+
+    // Only the vertices kept are in the grid: the first of each cell,
+    // then chained through `next`.
+    std::unordered_map<cell_t, std::uint32_t, cell_hash_t> first;
+    first.reserve(vertex_count);
+    std::vector<std::uint32_t> next(vertex_count, none);
+
+    std::vector<std::uint32_t> target(vertex_count);
+    std::iota(target.begin(), target.end(), 0);
+    size_t welded = 0;
+    for(std::uint32_t v = 0; v < vertex_count; ++v) {
+      const cell_t cell = cell_of(v);
+      for(std::int64_t dx = -1; dx <= 1 && target[v] == v; ++dx) {
+        for(std::int64_t dy = -1; dy <= 1 && target[v] == v; ++dy) {
+          for(std::int64_t dz = -1; dz <= 1 && target[v] == v; ++dz) {
+            const auto found = first.find({cell[0] + dx, cell[1] + dy, cell[2] + dz});
+            if(found == first.end()) {
+              continue;
+            }
+            for(auto kept = found->second; kept != none; kept = next[kept]) {
+              if(coincident(kept, v)) {
+                target[v] = kept;
+                ++welded;
+                break;
+              }
+            }
+          }
+        }
+      }
+      if(target[v] == v) {
+        auto [found, inserted] = first.try_emplace(cell, v);
+        if(!inserted) {
+          next[v] = found->second;
+          found->second = v;
+        }
+      }
+    }
+    if(welded == 0) {
+      return 0;
+    }
+
+    size_t kept = 0;
+    for(size_t t = 0; t < triangles.size(); t += 3) {
+      const Index a = target[triangles[t]];
+      const Index b = target[triangles[t+1]];
+      const Index c = target[triangles[t+2]];
+      if(a != b && b != c && c != a) {
+        triangles[kept++] = a;
+        triangles[kept++] = b;
+        triangles[kept++] = c;
+      }
+    }
+    triangles.resize(kept);
+    return welded;
+  }
+
+  /**
+   * Forsyth's greedy reordering: the next triangle is the best scored
+   * among those using a vertex in the (simulated, LRU) cache.
+   */
+  template<typename Index>
+  void reorder_triangles(std::vector<Index>& triangles, size_t vertex_count)
+  {
+    const size_t triangle_count = triangles.size() / 3;
+
+    // Triangles using each vertex, and how many are not emitted yet.
+    std::vector<std::uint32_t> offsets(vertex_count + 1, 0);
+    for(const auto index: triangles) {
+      ++offsets[index + 1];
+    }
+    std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    std::vector<std::uint32_t> remaining(vertex_count);
+    std::vector<std::uint32_t> adjacency(triangles.size());
+    for(size_t t = 0; t < triangle_count; ++t) {
+      for(size_t k = 0; k < 3; ++k) {
+        const auto v = triangles[3*t + k];
+        adjacency[offsets[v] + remaining[v]++] = t;
+      }
+    }
+
+    std::vector<std::uint32_t> cache_position(vertex_count, none);
+    std::vector<float> score(vertex_count);
+    for(size_t v = 0; v < vertex_count; ++v) {
+      score[v] = vertex_score(none, remaining[v]);
+    }
+    auto triangle_score = [&](size_t t) {
+      return score[triangles[3*t]] + score[triangles[3*t+1]] + score[triangles[3*t+2]];
+    };
+
+    std::vector<bool> emitted(triangle_count, false);
+    std::vector<Index> result;
+    result.reserve(triangles.size());
+
+    // Vertex cache (most recent first), with room for one more triangle.
+    std::vector<std::uint32_t> cache, next_cache;
+    cache.reserve(vertex_cache_size + 3);
+    next_cache.reserve(vertex_cache_size + 3);
+
+    std::uint32_t best = none;
+    float best_score = -std::numeric_limits<float>::max();
+    for(size_t t = 0; t < triangle_count; ++t) {
+      if(const float s = triangle_score(t); s > best_score) {
+        best_score = s;
+        best = t;
+      }
+    }
+
+    size_t cursor = 0;
+    for(size_t n = 0; n < triangle_count; ++n) {
+      if(best == none) {
+        // Nothing in the cache is useful: take the next one left.
+        while(emitted[cursor]) {
+          ++cursor;
+        }
+        best = cursor;
+      }
+      const auto* triangle = &triangles[3 * best];
+      emitted[best] = true;
+      result.insert(result.end(), triangle, triangle + 3);
+
+      for(size_t k = 0; k < 3; ++k) {
+        const auto v = triangle[k];
+        auto* begin = &adjacency[offsets[v]];
+        auto* end = begin + remaining[v];
+        std::iter_swap(std::find(begin, end, best), end - 1);
+        --remaining[v];
+      }
+
+      next_cache.assign(triangle, triangle + 3);
+      for(const auto v: cache) {
+        if(v != triangle[0] && v != triangle[1] && v != triangle[2]) {
+          next_cache.push_back(v);
+        }
+      }
+      for(size_t k = vertex_cache_size; k < next_cache.size(); ++k) {
+        const auto v = next_cache[k];
+        cache_position[v] = none;
+        score[v] = vertex_score(none, remaining[v]);
+      }
+      next_cache.resize(std::min(next_cache.size(), vertex_cache_size));
+      std::swap(cache, next_cache);
+
+      for(size_t k = 0; k < cache.size(); ++k) {
+        const auto v = cache[k];
+        cache_position[v] = k;
+        score[v] = vertex_score(k, remaining[v]);
+      }
+
+      best = none;
+      best_score = -std::numeric_limits<float>::max();
+      for(const auto v: cache) {
+        for(size_t a = offsets[v]; a < offsets[v] + remaining[v]; ++a) {
+          const auto t = adjacency[a];
+          if(const float s = triangle_score(t); s > best_score) {
+            best_score = s;
+            best = t;
+          }
+        }
+      }
+    }
+    triangles = std::move(result);
+  }
+
+  /**
+   * Renumbers the vertices in the order they are first used,
+   * and drops the unused ones.
+   */
+  template<typename Index>
+  void reorder_vertices(MeshChunk& chunk, std::vector<Index>& triangles, size_t entries)
+  {
+    const size_t vertex_count = chunk.vertex.size() / entries;
+    std::vector<std::uint32_t> remap(vertex_count, none);
+    std::uint32_t used = 0;
+    for(auto& index: triangles) {
+      if(remap[index] == none) {
+        remap[index] = used++;
+      }
+      index = remap[index];
+    }
+
+    std::vector<float> vertex(entries * used);
+    for(size_t v = 0; v < vertex_count; ++v) {
+      if(remap[v] != none) {
+        std::copy_n(&chunk.vertex[entries * v], entries, &vertex[entries * remap[v]]);
+      }
+    }
+    chunk.vertex = std::move(vertex);
+  }
+
+  template<typename Index>
+  VertexCacheStats optimize(MeshChunk& chunk, std::vector<Index>& triangles,
+                            size_t entries, bool weld_seams)
+  {
+    VertexCacheStats stats;
+    stats.trianglesBefore = triangles.size() / 3;
+    stats.missesBefore = fifo_misses(triangles, vertex_cache_size);
+
+    if(weld_seams) {
+      stats.welded = weld(chunk, triangles, entries);
+    }
+    reorder_triangles(triangles, chunk.vertex.size() / entries);
+    reorder_vertices(chunk, triangles, entries);
+
+    stats.trianglesAfter = triangles.size() / 3;
+    stats.missesAfter = fifo_misses(triangles, vertex_cache_size);
+    return stats;
+  }
+}
+
+
+size_t Mesh::cache_misses(const std::vector<std::uint16_t>& triangles, size_t cache_size)
+{
+  return fifo_misses(triangles, cache_size);
+}
+
+size_t Mesh::cache_misses(const std::vector<std::uint32_t>& triangles, size_t cache_size)
+{
+  return fifo_misses(triangles, cache_size);
+}
+
+VertexCacheStats Mesh::optimize_vertex_cache(MeshChunk& chunk, size_t entries_per_point,
+                                              bool weld_seams)
+{
+  assert(!chunk.isCompact() && "Optimize before compacting.");
+  if(chunk.isWide()) {
+    return optimize(chunk, chunk.wideIndexes, entries_per_point, weld_seams);
+  }
+  return optimize(chunk, chunk.indexes, entries_per_point, weld_seams);
+}
@@ -0,0 +1,64 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include "TessellationResult.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace Mesh
+{
+  /// Entries of the post-transform vertex cache we optimize for and measure.
+  constexpr size_t vertex_cache_size = 32;
+
+  /**
+   * Vertices transformed to draw the triangle list @a triangles
+   * with a FIFO post-transform cache of @a cache_size entries.
+   */
+  /// @{
+  size_t cache_misses(const std::vector<std::uint16_t>& triangles,
+                      size_t cache_size = vertex_cache_size);
+  size_t cache_misses(const std::vector<std::uint32_t>& triangles,
+                      size_t cache_size = vertex_cache_size);
+  /// @}
+
+  /**
+   * Makes a surface chunk cheaper to draw.
+   *
+   * 1. With @a weld_seams, merges vertices with the same position
+   *    and normal: the two sides of a periodic seam, or a pole.
+   *    Triangles left with repeated vertices are dropped.
+   *    Along a crease (different normals), vertices are kept apart.
+   * 2. Reorders the triangles for the post-transform vertex cache
+   *    (Tom Forsyth's "Linear-Speed Vertex Cache Optimisation").
+   * 3. Reorders the vertices in the order they are first used,
+   *    so they are fetched sequentially.
+   *
+   * @attention Call it before MeshChunk::compact() and MeshChunk::hash():
+   * the chunk must have its float `vertex`, with @a entries_per_point floats
+   * per vertex.
+   */
+  VertexCacheStats optimize_vertex_cache(MeshChunk& chunk, size_t entries_per_point,
+                                         bool weld_seams);
+}
@@ -0,0 +1,513 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "VertexPacking.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__SSE2__) && (defined(__GNUC__) || defined(__clang__))
+/// The AVX kernel is compiled anyway, and used if the CPU has AVX.
+#define PACKING_DISPATCH_AVX 1
+#define TARGET_AVX __attribute__((target("avx")))
+#endif
+
+using namespace Mesh;
+
+namespace {
+  template<bool with_bounds>
+  void pack_scalar(const double* positions, const double* normals,
+                   size_t count, float* out,
+                   bound_t& min_bound, bound_t& max_bound)
+  {
+    for(size_t k = 0; k < count; ++k) {
+      const double* p = positions + 3 * k;
+      for(int d = 0; d < 3; ++d) {
+        const float x = static_cast<float>(p[d]);
+        *out++ = x;
+        if constexpr(with_bounds) {
+          min_bound[d] = std::min(min_bound[d], x);
+          max_bound[d] = std::max(max_bound[d], x);
+        }
+      }
+      if(normals) {
+        const double* n = normals + 3 * k;
+        const double length = std::sqrt(n[0] * n[0] + n[1] * n[1] + n[2] * n[2]);
+        const double inverse = (length > 0) ? 1 / length : 0;
+        *out++ = static_cast<float>(n[0] * inverse);
+        *out++ = static_cast<float>(n[1] * inverse);
+        *out++ = static_cast<float>(n[2] * inverse);
+      }
+    }
+  }
+
+#if defined(__SSE2__)
+  /*
+   * Blocks of four points are loaded as they are in memory
+   * (x, y and z of each point, one after the other) into three registers:
+   *
+   *     a = (x0, y0, z0, x1)   b = (y1, z1, x2, y2)   c = (z2, x3, y3, z3)
+   *
+   * Positions are stored back as they are, and bounds are reduced
+   * lane by lane, so neither needs shuffling.
+   * Normals are split in x, y and z (see split()) only to get their lengths.
+   */
+
+  /// (x, y, z, x') and so on: see above.
+  struct block_t
+  {
+    __m128 a, b, c;
+  };
+
+  block_t load_block(const double* p)
+  {
+    auto load4 = [](const double* q) {
+      return _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(q)), _mm_cvtpd_ps(_mm_loadu_pd(q + 2)));
+    };
+    return {load4(p), load4(p + 4), load4(p + 8)};
+  }
+
+  /// The x, y and z of the four points of @a block.
+  block_t split(const block_t& block)
+  {
+    const auto& [a, b, c] = block;
+    const __m128 b2c1 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 a1b0 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    const __m128 b3c2 = _mm_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    const __m128 a2b1 = _mm_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m128 c0c3 = _mm_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+    return {_mm_shuffle_ps(a, b2c1, _MM_SHUFFLE(2, 0, 3, 0)),
+            _mm_shuffle_ps(a1b0, b3c2, _MM_SHUFFLE(2, 0, 2, 0)),
+            _mm_shuffle_ps(a2b1, c0c3, _MM_SHUFFLE(2, 0, 2, 0))};
+  }
+
+  /// The normals of @a block divided by their lengths, or zero.
+  block_t normalize(const block_t& block)
+  {
+    const auto& [a, b, c] = block;
+    const auto [x2, y2, z2] = split({_mm_mul_ps(a, a), _mm_mul_ps(b, b), _mm_mul_ps(c, c)});
+    const __m128 sum = _mm_add_ps(_mm_add_ps(x2, y2), z2);
+    const __m128 nonzero = _mm_cmpgt_ps(sum, _mm_setzero_ps());
+    const __m128 s = _mm_and_ps(_mm_div_ps(_mm_set1_ps(1), _mm_sqrt_ps(sum)), nonzero);
+    return {_mm_mul_ps(a, _mm_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 0, 0))),
+            _mm_mul_ps(b, _mm_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 1, 1))),
+            _mm_mul_ps(c, _mm_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 2)))};
+  }
+
+  struct interleaved_t
+  {
+    __m128 r[6];
+  };
+
+  /**
+   * Positions @a p and normals @a n interleaved,
+   * (p0, n0, p1, n1, ...), in six registers.
+   */
+  interleaved_t interleave(const block_t& p, const block_t& n)
+  {
+    const __m128 pa2na0 = _mm_shuffle_ps(p.a, n.a, _MM_SHUFFLE(0, 0, 2, 2));
+    const __m128 pa3pb0 = _mm_shuffle_ps(p.a, p.b, _MM_SHUFFLE(0, 0, 3, 3));
+    const __m128 pb1na3 = _mm_shuffle_ps(p.b, n.a, _MM_SHUFFLE(3, 3, 1, 1));
+    const __m128 pc0nb2 = _mm_shuffle_ps(p.c, n.b, _MM_SHUFFLE(2, 2, 0, 0));
+    const __m128 nb3nc0 = _mm_shuffle_ps(n.b, n.c, _MM_SHUFFLE(0, 0, 3, 3));
+    const __m128 pc3nc1 = _mm_shuffle_ps(p.c, n.c, _MM_SHUFFLE(1, 1, 3, 3));
+    return {{_mm_shuffle_ps(p.a, pa2na0, _MM_SHUFFLE(2, 0, 1, 0)),
+            _mm_shuffle_ps(n.a, pa3pb0, _MM_SHUFFLE(2, 0, 2, 1)),
+            _mm_shuffle_ps(pb1na3, n.b, _MM_SHUFFLE(1, 0, 2, 0)),
+            _mm_shuffle_ps(p.b, pc0nb2, _MM_SHUFFLE(2, 0, 3, 2)),
+            _mm_shuffle_ps(nb3nc0, p.c, _MM_SHUFFLE(2, 1, 2, 0)),
+            _mm_shuffle_ps(pc3nc1, n.c, _MM_SHUFFLE(3, 2, 2, 0))}};
+  }
+
+  /// Three doubles as (x, y, z, 0).
+  __m128 load3(const double* p)
+  {
+    return _mm_movelh_ps(_mm_cvtpd_ps(_mm_loadu_pd(p)), _mm_cvtpd_ps(_mm_load_sd(p + 2)));
+  }
+
+  /// Three floats as (x, y, z, 0). Does not read past @a p + 2.
+  __m128 load3(const float* p)
+  {
+    const __m128 xy = _mm_castpd_ps(_mm_load_sd(reinterpret_cast<const double*>(p)));
+    return _mm_movelh_ps(xy, _mm_load_ss(p + 2));
+  }
+
+  /// Stores x, y and z only.
+  void store3(float* out, __m128 v)
+  {
+    _mm_storel_pi(reinterpret_cast<__m64*>(out), v);
+    _mm_store_ss(out + 2, _mm_movehl_ps(v, v));
+  }
+
+  /// The vector divided by its length, or zero.
+  __m128 normalize(__m128 v)
+  {
+    const __m128 squares = _mm_mul_ps(v, v);
+    __m128 sum = _mm_add_ps(squares, _mm_shuffle_ps(squares, squares, _MM_SHUFFLE(2, 3, 0, 1)));
+    sum = _mm_add_ps(sum, _mm_shuffle_ps(sum, sum, _MM_SHUFFLE(1, 0, 3, 2)));
+    const __m128 nonzero = _mm_cmpgt_ps(sum, _mm_setzero_ps());
+    const __m128 inverse = _mm_div_ps(_mm_set1_ps(1), _mm_sqrt_ps(sum));
+    return _mm_and_ps(_mm_mul_ps(v, inverse), nonzero);
+  }
+
+  __m128 load_bound(const bound_t& bound)
+  {
+    return _mm_set_ps(0, bound[2], bound[1], bound[0]);
+  }
+
+  /**
+   * Bounds of the blocks, lane by lane, as loaded:
+   * the x, y and z of each register are reduced at the end (see reduce()).
+   */
+  struct block_bounds_t
+  {
+    block_t lowest{_mm_set1_ps(std::numeric_limits<float>::max()),
+                   _mm_set1_ps(std::numeric_limits<float>::max()),
+                   _mm_set1_ps(std::numeric_limits<float>::max())};
+    block_t highest{_mm_set1_ps(-std::numeric_limits<float>::max()),
+                    _mm_set1_ps(-std::numeric_limits<float>::max()),
+                    _mm_set1_ps(-std::numeric_limits<float>::max())};
+
+    void extend(const block_t& block)
+    {
+      lowest = {_mm_min_ps(lowest.a, block.a), _mm_min_ps(lowest.b, block.b),
+                _mm_min_ps(lowest.c, block.c)};
+      highest = {_mm_max_ps(highest.a, block.a), _mm_max_ps(highest.b, block.b),
+                 _mm_max_ps(highest.c, block.c)};
+    }
+
+    /// Extends (x, y, z, 0) vectors with the bounds of the blocks.
+    void reduce(__m128& low, __m128& high) const
+    {
+      auto horizontal = [](block_t xyz, auto op) {
+        // The minimum (or maximum) of the four lanes of x, of y and of z.
+        for(auto* v: {&xyz.a, &xyz.b, &xyz.c}) {
+          *v = op(*v, _mm_shuffle_ps(*v, *v, _MM_SHUFFLE(2, 3, 0, 1)));
+          *v = op(*v, _mm_shuffle_ps(*v, *v, _MM_SHUFFLE(1, 0, 3, 2)));
+        }
+        return _mm_movelh_ps(_mm_unpacklo_ps(xyz.a, xyz.b), xyz.c);
+      };
+      low = _mm_min_ps(low, horizontal(split(lowest), [](__m128 x, __m128 y) {
+        return _mm_min_ps(x, y);
+      }));
+      high = _mm_max_ps(high, horizontal(split(highest), [](__m128 x, __m128 y) {
+        return _mm_max_ps(x, y);
+      }));
+    }
+  };
+
+  /**
+   * Four points per iteration, and the rest one by one.
+   * Also packs the last points of pack_avx().
+   */
+  template<bool with_bounds>
+  void pack_sse2(const double* positions, const double* normals,
+                 size_t count, float* out,
+                 bound_t& min_bound, bound_t& max_bound)
+  {
+    block_bounds_t bounds;
+    const size_t entries = normals ? 6 : 3;
+    size_t k = 0;
+    for(; k + 4 <= count; k += 4, out += 4 * entries) {
+      const block_t position = load_block(positions + 3 * k);
+      if constexpr(with_bounds) {
+        bounds.extend(position);
+      }
+      if(normals) {
+        const interleaved_t interleaved = interleave(position, normalize(load_block(normals + 3 * k)));
+        for(size_t r = 0; r < 6; ++r) {
+          _mm_storeu_ps(out + 4 * r, interleaved.r[r]);
+        }
+      } else {
+        _mm_storeu_ps(out, position.a);
+        _mm_storeu_ps(out + 4, position.b);
+        _mm_storeu_ps(out + 8, position.c);
+      }
+    }
+
+    __m128 lowest = load_bound(min_bound);
+    __m128 highest = load_bound(max_bound);
+    for(; k < count; ++k, out += entries) {
+      const __m128 position = load3(positions + 3 * k);
+      store3(out, position);
+      if constexpr(with_bounds) {
+        lowest = _mm_min_ps(lowest, position);
+        highest = _mm_max_ps(highest, position);
+      }
+      if(normals) {
+        store3(out + 3, normalize(load3(normals + 3 * k)));
+      }
+    }
+    if constexpr(with_bounds) {
+      bounds.reduce(lowest, highest);
+      store3(min_bound.data(), lowest);
+      store3(max_bound.data(), highest);
+    }
+  }
+#endif
+
+#if defined(PACKING_DISPATCH_AVX)
+  /*
+   * Two blocks of four points per iteration, one in each 128-bit lane
+   * of the AVX registers. AVX shuffles work lane by lane,
+   * so the shuffles are those of the SSE2 kernel.
+   */
+
+  struct avx_block_t
+  {
+    __m256 a, b, c;
+  };
+
+  /// Four points at @a p in the first lane, and the next four in the second.
+  TARGET_AVX __m256 load_lanes(const double* p)
+  {
+    const __m128 first = _mm256_cvtpd_ps(_mm256_loadu_pd(p));
+    const __m128 second = _mm256_cvtpd_ps(_mm256_loadu_pd(p + 12));
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(first), second, 1);
+  }
+
+  TARGET_AVX avx_block_t load_avx_block(const double* p)
+  {
+    return {load_lanes(p), load_lanes(p + 4), load_lanes(p + 8)};
+  }
+
+  TARGET_AVX avx_block_t split(const avx_block_t& block)
+  {
+    const auto& [a, b, c] = block;
+    const __m256 b2c1 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m256 a1b0 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(0, 0, 1, 1));
+    const __m256 b3c2 = _mm256_shuffle_ps(b, c, _MM_SHUFFLE(2, 2, 3, 3));
+    const __m256 a2b1 = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(1, 1, 2, 2));
+    const __m256 c0c3 = _mm256_shuffle_ps(c, c, _MM_SHUFFLE(3, 3, 0, 0));
+    return {_mm256_shuffle_ps(a, b2c1, _MM_SHUFFLE(2, 0, 3, 0)),
+            _mm256_shuffle_ps(a1b0, b3c2, _MM_SHUFFLE(2, 0, 2, 0)),
+            _mm256_shuffle_ps(a2b1, c0c3, _MM_SHUFFLE(2, 0, 2, 0))};
+  }
+
+  TARGET_AVX avx_block_t normalize(const avx_block_t& block)
+  {
+    const auto& [a, b, c] = block;
+    const auto [x2, y2, z2] = split(avx_block_t{_mm256_mul_ps(a, a), _mm256_mul_ps(b, b),
+                                                _mm256_mul_ps(c, c)});
+    const __m256 sum = _mm256_add_ps(_mm256_add_ps(x2, y2), z2);
+    const __m256 nonzero = _mm256_cmp_ps(sum, _mm256_setzero_ps(), _CMP_GT_OQ);
+    const __m256 s = _mm256_and_ps(_mm256_div_ps(_mm256_set1_ps(1), _mm256_sqrt_ps(sum)),
+                                   nonzero);
+    return {_mm256_mul_ps(a, _mm256_shuffle_ps(s, s, _MM_SHUFFLE(1, 0, 0, 0))),
+            _mm256_mul_ps(b, _mm256_shuffle_ps(s, s, _MM_SHUFFLE(2, 2, 1, 1))),
+            _mm256_mul_ps(c, _mm256_shuffle_ps(s, s, _MM_SHUFFLE(3, 3, 3, 2)))};
+  }
+
+  struct avx_interleaved_t
+  {
+    __m256 r[6];
+  };
+
+  TARGET_AVX avx_interleaved_t interleave(const avx_block_t& p, const avx_block_t& n)
+  {
+    const __m256 pa2na0 = _mm256_shuffle_ps(p.a, n.a, _MM_SHUFFLE(0, 0, 2, 2));
+    const __m256 pa3pb0 = _mm256_shuffle_ps(p.a, p.b, _MM_SHUFFLE(0, 0, 3, 3));
+    const __m256 pb1na3 = _mm256_shuffle_ps(p.b, n.a, _MM_SHUFFLE(3, 3, 1, 1));
+    const __m256 pc0nb2 = _mm256_shuffle_ps(p.c, n.b, _MM_SHUFFLE(2, 2, 0, 0));
+    const __m256 nb3nc0 = _mm256_shuffle_ps(n.b, n.c, _MM_SHUFFLE(0, 0, 3, 3));
+    const __m256 pc3nc1 = _mm256_shuffle_ps(p.c, n.c, _MM_SHUFFLE(1, 1, 3, 3));
+    return {{_mm256_shuffle_ps(p.a, pa2na0, _MM_SHUFFLE(2, 0, 1, 0)),
+            _mm256_shuffle_ps(n.a, pa3pb0, _MM_SHUFFLE(2, 0, 2, 1)),
+            _mm256_shuffle_ps(pb1na3, n.b, _MM_SHUFFLE(1, 0, 2, 0)),
+            _mm256_shuffle_ps(p.b, pc0nb2, _MM_SHUFFLE(2, 0, 3, 2)),
+            _mm256_shuffle_ps(nb3nc0, p.c, _MM_SHUFFLE(2, 1, 2, 0)),
+            _mm256_shuffle_ps(pc3nc1, n.c, _MM_SHUFFLE(3, 2, 2, 0))}};
+  }
+
+  /**
+   * Stores @a r registers of two blocks: the first lanes,
+   * and then the second lanes.
+   */
+  template<size_t r>
+  TARGET_AVX void store_blocks(float* out, const __m256 (&registers)[r])
+  {
+    for(size_t k = 0; k < r; ++k) {
+      _mm_storeu_ps(out + 4 * k, _mm256_castps256_ps128(registers[k]));
+      _mm_storeu_ps(out + 4 * (r + k), _mm256_extractf128_ps(registers[k], 1));
+    }
+  }
+
+  /**
+   * Eight points per iteration, and the rest with pack_sse2().
+   */
+  template<bool with_bounds>
+  TARGET_AVX void pack_avx(const double* positions, const double* normals,
+                           size_t count, float* out,
+                           bound_t& min_bound, bound_t& max_bound)
+  {
+    const size_t entries = normals ? 6 : 3;
+    avx_block_t lowest{_mm256_set1_ps(std::numeric_limits<float>::max()),
+                       _mm256_set1_ps(std::numeric_limits<float>::max()),
+                       _mm256_set1_ps(std::numeric_limits<float>::max())};
+    avx_block_t highest{_mm256_set1_ps(-std::numeric_limits<float>::max()),
+                        _mm256_set1_ps(-std::numeric_limits<float>::max()),
+                        _mm256_set1_ps(-std::numeric_limits<float>::max())};
+    size_t k = 0;
+    for(; k + 8 <= count; k += 8, out += 8 * entries) {
+      const avx_block_t position = load_avx_block(positions + 3 * k);
+      if constexpr(with_bounds) {
+        lowest = {_mm256_min_ps(lowest.a, position.a), _mm256_min_ps(lowest.b, position.b),
+                  _mm256_min_ps(lowest.c, position.c)};
+        highest = {_mm256_max_ps(highest.a, position.a), _mm256_max_ps(highest.b, position.b),
+                   _mm256_max_ps(highest.c, position.c)};
+      }
+      if(normals) {
+        store_blocks(out, interleave(position, normalize(load_avx_block(normals + 3 * k))).r);
+      } else {
+        const __m256 registers[] = {position.a, position.b, position.c};
+        store_blocks(out, registers);
+      }
+    }
+
+    if constexpr(with_bounds) {
+      // Both lanes are blocks of points: fold them, and then the blocks.
+      auto fold = [](const avx_block_t& block, auto op) TARGET_AVX {
+        return block_t{op(_mm256_castps256_ps128(block.a), _mm256_extractf128_ps(block.a, 1)),
+                       op(_mm256_castps256_ps128(block.b), _mm256_extractf128_ps(block.b, 1)),
+                       op(_mm256_castps256_ps128(block.c), _mm256_extractf128_ps(block.c, 1))};
+      };
+      block_bounds_t bounds;
+      bounds.lowest = fold(lowest, [](__m128 x, __m128 y) { return _mm_min_ps(x, y); });
+      bounds.highest = fold(highest, [](__m128 x, __m128 y) { return _mm_max_ps(x, y); });
+      __m128 low = load_bound(min_bound);
+      __m128 high = load_bound(max_bound);
+      bounds.reduce(low, high);
+      store3(min_bound.data(), low);
+      store3(max_bound.data(), high);
+    }
+    // Avoids the penalty of mixing AVX and SSE code.
+    _mm256_zeroupper();
+    pack_sse2<with_bounds>(positions + 3 * k, normals ? normals + 3 * k : nullptr,
+                           count - k, out, min_bound, max_bound);
+  }
+
+  bool cpu_has_avx()
+  {
+    static const bool result = __builtin_cpu_supports("avx");
+    return result;
+  }
+#endif
+
+  template<bool with_bounds>
+  void pack(const double* positions, const double* normals,
+            size_t count, float* out,
+            bound_t& min_bound, bound_t& max_bound)
+  {
+#if defined(PACKING_DISPATCH_AVX)
+    if(cpu_has_avx()) {
+      pack_avx<with_bounds>(positions, normals, count, out, min_bound, max_bound);
+      return;
+    }
+#endif
+#if defined(__SSE2__)
+    pack_sse2<with_bounds>(positions, normals, count, out, min_bound, max_bound);
+#else
+    pack_scalar<with_bounds>(positions, normals, count, out, min_bound, max_bound);
+#endif
+  }
+}
+
+
+void Mesh::pack_vertices(const double* positions, const double* normals,
+                         size_t count, float* out)
+{
+  bound_t unused{};
+  pack<false>(positions, normals, count, out, unused, unused);
+}
+
+
+void Mesh::pack_vertices(const double* positions, const double* normals,
+                         size_t count, float* out,
+                         bound_t& min_bound, bound_t& max_bound)
+{
+  pack<true>(positions, normals, count, out, min_bound, max_bound);
+}
+
+
+void Mesh::reduce_bounds(const float* vertex, size_t count, size_t stride,
+                         bound_t& min_bound, bound_t& max_bound)
+{
+#if defined(__SSE2__)
+  __m128 lowest = load_bound(min_bound);
+  __m128 highest = load_bound(max_bound);
+  for(size_t k = 0; k < count; ++k, vertex += stride) {
+    const __m128 position = load3(vertex);
+    lowest = _mm_min_ps(lowest, position);
+    highest = _mm_max_ps(highest, position);
+  }
+  store3(min_bound.data(), lowest);
+  store3(max_bound.data(), highest);
+#else
+  for(size_t k = 0; k < count; ++k, vertex += stride) {
+    for(int d = 0; d < 3; ++d) {
+      min_bound[d] = std::min(min_bound[d], vertex[d]);
+      max_bound[d] = std::max(max_bound[d], vertex[d]);
+    }
+  }
+#endif
+}
+
+
+void Mesh::pack_vertices_scalar(const double* positions, const double* normals,
+                                size_t count, float* out,
+                                bound_t& min_bound, bound_t& max_bound)
+{
+  pack_scalar<true>(positions, normals, count, out, min_bound, max_bound);
+}
+
+
+
+void Mesh::pack_vertices_sse2(const double* positions, const double* normals,
+                              size_t count, float* out,
+                              bound_t& min_bound, bound_t& max_bound)
+{
+#if defined(__SSE2__)
+  pack_sse2<true>(positions, normals, count, out, min_bound, max_bound);
+#else
+  pack_scalar<true>(positions, normals, count, out, min_bound, max_bound);
+#endif
+}
+
+
+const char* Mesh::packing_instruction_set()
+{
+#if defined(PACKING_DISPATCH_AVX)
+  if(cpu_has_avx()) {
+    return "AVX";
+  }
+#endif
+#if defined(__SSE2__)
+  return "SSE2";
+#else
+  return "scalar";
+#endif
+}
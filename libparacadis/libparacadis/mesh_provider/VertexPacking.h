@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+
+/*
+ * Kernels that turn evaluated points (doubles) into vertex buffers (floats).
+ *
+ * They use SSE2 when the compiler targets it, four points at a time,
+ * and AVX, eight points at a time, if the CPU has it (checked at run time).
+ * Plain C++ otherwise.
+ */
+namespace Mesh
+{
+  using bound_t = std::array<float, 3>;
+
+  /**
+   * Converts @a count points to floats and writes them interleaved to @a out:
+   * the position, and the unit normal if @a normals is not null.
+   * Zero normals stay zero.
+   *
+   * @param positions x, y and z of each point, one after the other
+   * (a 3 x count gsMatrix, for instance).
+   * @param normals like @a positions, not necessarily unit. May be null.
+   * @param out room for 3 (or 6, with normals) floats per point.
+   */
+  void pack_vertices(const double* positions, const double* normals,
+                     size_t count, float* out);
+
+  /**
+   * Like pack_vertices(), and extends the bounds with the positions
+   * in the same pass.
+   */
+  void pack_vertices(const double* positions, const double* normals,
+                     size_t count, float* out,
+                     bound_t& min_bound, bound_t& max_bound);
+
+  /**
+   * Extends the bounds with the positions in @a vertex:
+   * @a count points, each one @a stride floats after the previous one.
+   */
+  void reduce_bounds(const float* vertex, size_t count, size_t stride,
+                     bound_t& min_bound, bound_t& max_bound);
+
+  /**
+   * The plain C++ version of pack_vertices(),
+   * for reference in tests and benchmarks.
+   */
+  void pack_vertices_scalar(const double* positions, const double* normals,
+                            size_t count, float* out,
+                            bound_t& min_bound, bound_t& max_bound);
+
+  /**
+   * The SSE2 version of pack_vertices() (or the plain one, without SSE2),
+   * to test it on CPUs where pack_vertices() uses AVX.
+   */
+  void pack_vertices_sse2(const double* positions, const double* normals,
+                          size_t count, float* out,
+                          bound_t& min_bound, bound_t& max_bound);
+
+  /// "AVX", "SSE2" or "scalar": the version pack_vertices() uses on this CPU.
+  const char* packing_instruction_set();
+}
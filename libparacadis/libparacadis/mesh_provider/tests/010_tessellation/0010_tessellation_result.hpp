@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/mesh_provider/TessellationResult.h>
+
+#include <gismo/gismo.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Mesh;
+
+namespace {
+  /**
+   * Largest distance between a vertex of @a result
+   * and the sphere of radius @a radius centered at the origin.
+   */
+  real_t radial_error(const TessellationResult& result, real_t radius)
+  {
+    const auto entries = result.entriesPerPoint();
+    real_t error = 0;
+    for(const auto& chunk: result.chunks) {
+      for(size_t k = 0; k < chunk.vertex.size(); k += entries) {
+        const real_t distance = std::hypot(chunk.vertex[k], chunk.vertex[k+1], chunk.vertex[k+2]);
+        error = std::max(error, std::abs(distance - radius));
+      }
+    }
+    return error;
+  }
+}
+
+SCENARIO("Tessellating without a renderer", "[simple]")
+{
+  GIVEN("a unit sphere")
+  {
+    const std::shared_ptr<const iga_geometry_t> sphere{
+        gismo::gsNurbsCreator<real_t>::NurbsSphere(1)};
+    TessellationParameters parameters;
+    parameters.chordalTolerance = 1e-3;
+
+    WHEN("it is tessellated")
+    {
+      const auto result = tessellate(*sphere, parameters);
+
+      THEN("it is a triangulated surface")
+      {
+        REQUIRE(result.dimension == 2);
+        REQUIRE(result.entriesPerPoint() == 6);
+        REQUIRE(!result.chunks.empty());
+        REQUIRE(result.triangleCount() > 0);
+        REQUIRE(result.byteSize() > 0);
+      }
+
+      THEN("the vertices are on the sphere")
+      {
+        REQUIRE(radial_error(result, 1) < 1e-6);
+      }
+
+      THEN("normals are unit and radial, except where the surface is degenerate")
+      {
+        bool all_good = true;
+        for(const auto& chunk: result.chunks) {
+          for(size_t k = 0; k < chunk.vertex.size(); k += 6) {
+            const float* p = &chunk.vertex[k];
+            const float* n = p + 3;
+            const real_t length = std::hypot(n[0], n[1], n[2]);
+            if(length == 0) {
+              // A pole.
+              all_good = all_good && std::abs(std::abs(p[2]) - 1) < 1e-6;
+              continue;
+            }
+            const real_t radial = p[0]*n[0] + p[1]*n[1] + p[2]*n[2];
+            all_good = all_good && std::abs(length - 1) < 1e-5
+                                && std::abs(std::abs(radial) - 1) < 1e-5;
+          }
+        }
+        REQUIRE(all_good);
+      }
+
+      THEN("the indexes address the vertices of their chunk")
+      {
+        bool all_good = true;
+        for(const auto& chunk: result.chunks) {
+          const size_t vertices = chunk.vertex.size() / 6;
+          all_good = all_good && vertices <= MeshChunk::max_vertices;
+          all_good = all_good && !chunk.isWide();
+          all_good = all_good && chunk.indexCount() % 3 == 0;
+          for(auto index: chunk.indexes) {
+            all_good = all_good && index < vertices;
+          }
+        }
+        REQUIRE(all_good);
+      }
+
+      THEN("the bounds contain the sphere")
+      {
+        for(const auto& chunk: result.chunks) {
+          for(int d = 0; d < 3; ++d) {
+            REQUIRE(chunk.min_bound[d] >= -1.0001f);
+            REQUIRE(chunk.max_bound[d] <= 1.0001f);
+            REQUIRE(chunk.min_bound[d] <= chunk.max_bound[d]);
+          }
+        }
+      }
+    }
+
+    WHEN("the tolerance is smaller")
+    {
+      const auto coarse = tessellate(*sphere, parameters);
+      parameters.chordalTolerance /= 16;
+      const auto fine = tessellate(*sphere, parameters);
+
+      THEN("there are more vertices")
+      {
+        REQUIRE(fine.vertexCount() > coarse.vertexCount());
+        REQUIRE(fine.triangleCount() > coarse.triangleCount());
+      }
+    }
+
+    WHEN("it is tessellated in the compact format")
+    {
+      const auto floats = tessellate(*sphere, parameters);
+      parameters.vertexFormat = VertexFormat::COMPACT;
+      const auto result = tessellate(*sphere, parameters);
+
+      THEN("every chunk is compact")
+      {
+        for(const auto& chunk: result.chunks) {
+          REQUIRE(chunk.isCompact());
+          REQUIRE(chunk.vertex.empty());
+          REQUIRE(chunk.vertexBytes() == sizeof(CompactVertex) * chunk.compactVertex.size());
+        }
+      }
+
+      THEN("the frame encloses the sphere, with some room")
+      {
+        const auto& frame = result.frame;
+        for(int d = 0; d < 3; ++d) {
+          REQUIRE(frame.offset[d] - frame.scale < -1);
+          REQUIRE(frame.offset[d] + frame.scale > 1);
+        }
+        REQUIRE(frame.scale <= 4);
+      }
+
+      THEN("the positions in the frame are the float positions, up to a quantization step")
+      {
+        const auto& frame = result.frame;
+        const float step = frame.scale / 32767;
+        REQUIRE(result.chunks.size() == floats.chunks.size());
+        bool all_good = true;
+        for(size_t k = 0; k < result.chunks.size(); ++k) {
+          const auto& compact = result.chunks[k].compactVertex;
+          const auto& vertex = floats.chunks[k].vertex;
+          REQUIRE(6 * compact.size() == vertex.size());
+          for(size_t v = 0; v < compact.size(); ++v) {
+            all_good = all_good && compact[v].position[3] == 32767;
+            for(int d = 0; d < 3; ++d) {
+              const float position = frame.offset[d] + step * compact[v].position[d];
+              all_good = all_good && std::abs(position - vertex[6*v + d]) <= step;
+            }
+          }
+        }
+        REQUIRE(all_good);
+      }
+    }
+
+    WHEN("the tessellation is cancelled")
+    {
+      Threads::CancellationToken cancel;
+      cancel.cancel();
+      const auto result = tessellate(*sphere, parameters, cancel);
+
+      THEN("nothing is returned")
+      {
+        REQUIRE(result.chunks.empty());
+      }
+    }
+  }
+
+  GIVEN("many spheres")
+  {
+    std::vector<std::shared_ptr<const iga_geometry_t>> spheres;
+    for(int k = 1; k <= 8; ++k) {
+      spheres.emplace_back(gismo::gsNurbsCreator<real_t>::NurbsSphere(k));
+    }
+
+    WHEN("they are tessellated in a batch")
+    {
+      const auto results = tessellate_all(spheres, {});
+
+      THEN("each result is the tessellation of its geometry")
+      {
+        REQUIRE(results.size() == spheres.size());
+        for(size_t k = 0; k < results.size(); ++k) {
+          REQUIRE(results[k].dimension == 2);
+          REQUIRE(radial_error(results[k], k + 1) < 1e-5 * (k + 1));
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,86 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <libparacadis/mesh_provider/BasisGridCache.h>
+#include <libparacadis/mesh_provider/TessellationResult.h>
+
+#include <gismo/gismo.h>
+
+#include <format>
+#include <memory>
+#include <vector>
+
+using namespace Mesh;
+
+TEST_CASE("Tessellating spheres", "[benchmark]")
+{
+  const std::shared_ptr<const iga_geometry_t> sphere{
+      gismo::gsNurbsCreator<real_t>::NurbsSphere(1)};
+
+  for(real_t tolerance: {1e-2, 1e-3, 1e-4}) {
+    TessellationParameters parameters;
+    parameters.chordalTolerance = tolerance;
+    const auto result = tessellate(*sphere, parameters);
+    REQUIRE(result.triangleCount() > 0);
+
+    BENCHMARK(std::format("one sphere, tolerance {} ({} vertices)",
+                          tolerance, result.vertexCount()))
+    {
+      return tessellate(*sphere, parameters);
+    };
+
+    const Document::AnalyticShape analytic = Document::AnalyticSphere{{0, 0, 0}, 1};
+    const auto closed_form = tessellate(analytic, parameters);
+    BENCHMARK(std::format("one sphere in closed form, tolerance {} ({} vertices)",
+                          tolerance, closed_form.vertexCount()))
+    {
+      return tessellate(analytic, parameters);
+    };
+  }
+
+  std::vector<std::shared_ptr<const iga_geometry_t>> spheres;
+  for(int k = 1; k <= 64; ++k) {
+    spheres.emplace_back(gismo::gsNurbsCreator<real_t>::NurbsSphere(k));
+  }
+  BENCHMARK("a batch of 64 spheres, tolerance 1e-2")
+  {
+    return tessellate_all(spheres, {});
+  };
+
+  // Dragging moves control points: the basis grid can be reused.
+  const std::shared_ptr<const iga_geometry_t> edited{
+      gismo::gsNurbsCreator<real_t>::NurbsSphere(1, 0, 0, 0.5)};
+  TessellationParameters parameters;
+  parameters.chordalTolerance = 1e-4;
+  BENCHMARK("an edited sphere, tolerance 1e-4, basis grid cached")
+  {
+    return tessellate(*edited, parameters);
+  };
+  BENCHMARK("an edited sphere, tolerance 1e-4, basis grid evaluated")
+  {
+    BasisGridCache::global().clear();
+    return tessellate(*edited, parameters);
+  };
+}
@@ -0,0 +1,88 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/mesh_provider/GridEvaluator.h>
+
+#include <gismo/gismo.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Mesh;
+
+SCENARIO("Evaluating a surface on a grid", "[simple]")
+{
+  GIVEN("a sphere and a grid of parameters")
+  {
+    const std::unique_ptr<const iga_geometry_t> sphere{
+        gismo::gsNurbsCreator<real_t>::NurbsSphere(2, 1, 0, 0)};
+    const gismo::gsMatrix<real_t> range = sphere->parameterRange();
+    std::vector<std::vector<real_t>> samples(2);
+    for(int d = 0; d < 2; ++d) {
+      for(int k = 0; k <= 20; ++k) {
+        samples[d].push_back(range(d, 0) + (range(d, 1) - range(d, 0)) * k / 20);
+      }
+    }
+
+    WHEN("positions and normals are evaluated in one pass")
+    {
+      const GridEvaluator evaluator{*sphere, samples};
+      REQUIRE(evaluator.cols() == 21);
+      REQUIRE(evaluator.rows() == 21);
+      REQUIRE(evaluator.isTensor());
+
+      std::vector<float> fused(GridEvaluator::entries * 21 * 21);
+      // In two parts, like tiles do.
+      evaluator.evaluate(0, 8, fused.data());
+      evaluator.evaluate(8, 13, fused.data() + GridEvaluator::entries * 8 * 21);
+
+      THEN("they match the geometry's own evaluation")
+      {
+        const auto points = grid_points(samples);
+        const auto positions = sphere->eval(points);
+        const auto normals = gismo::gsNormalField<real_t>{*sphere}.eval(points);
+
+        bool all_good = true;
+        for(index_t k = 0; k < points.cols(); ++k) {
+          const float* p = &fused[GridEvaluator::entries * k];
+          const float* n = p + 3;
+          for(int d = 0; d < 3; ++d) {
+            all_good = all_good && std::abs(p[d] - positions(d, k)) < 1e-5;
+          }
+          if(n[0] == 0 && n[1] == 0 && n[2] == 0) {
+            // A pole.
+            all_good = all_good && std::abs(std::abs(p[2]) - 2) < 1e-5;
+            continue;
+          }
+          const auto expected = normals.col(k).normalized();
+          for(int d = 0; d < 3; ++d) {
+            all_good = all_good && std::abs(n[d] - expected[d]) < 1e-5;
+          }
+        }
+        REQUIRE(all_good);
+      }
+    }
+  }
+}
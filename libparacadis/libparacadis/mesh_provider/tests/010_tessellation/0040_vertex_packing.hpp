@@ -0,0 +1,169 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/mesh_provider/VertexPacking.h>
+
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+using namespace Mesh;
+
+SCENARIO("Packing evaluated points into vertex buffers", "[simple]")
+{
+  GIVEN("random positions and normals, and a few zero normals")
+  {
+    constexpr size_t count = 1001;
+    std::mt19937 generator{42};
+    std::uniform_real_distribution<double> random{-100, 100};
+    std::vector<double> positions(3 * count);
+    std::vector<double> normals(3 * count);
+    for(auto& x: positions) { x = random(generator); }
+    for(auto& x: normals) { x = random(generator); }
+    for(size_t k = 0; k < count; k += 100) {
+      normals[3*k] = normals[3*k+1] = normals[3*k+2] = 0;
+    }
+
+    bound_t min_bound, max_bound, reference_min, reference_max;
+    min_bound.fill(std::numeric_limits<float>::max());
+    max_bound.fill(-std::numeric_limits<float>::max());
+    reference_min = min_bound;
+    reference_max = max_bound;
+
+    WHEN("they are packed with normals")
+    {
+      // One float more, to catch writes past the end.
+      std::vector<float> packed(6 * count + 1, -1);
+      std::vector<float> reference(6 * count);
+      pack_vertices(positions.data(), normals.data(), count, packed.data(),
+                    min_bound, max_bound);
+      pack_vertices_scalar(positions.data(), normals.data(), count, reference.data(),
+                           reference_min, reference_max);
+
+      THEN("they match the plain C++ kernel")
+      {
+        INFO(packing_instruction_set());
+        REQUIRE(packed.back() == -1);
+        bool all_good = true;
+        for(size_t k = 0; k < 6 * count; ++k) {
+          all_good = all_good && std::abs(packed[k] - reference[k]) < 1e-6f * std::max(1.f, std::abs(reference[k]));
+        }
+        REQUIRE(all_good);
+        REQUIRE(min_bound == reference_min);
+        REQUIRE(max_bound == reference_max);
+      }
+
+      THEN("normals are unit, or zero")
+      {
+        bool all_good = true;
+        for(size_t k = 0; k < count; ++k) {
+          const float* n = &packed[6*k + 3];
+          const float length = std::hypot(n[0], n[1], n[2]);
+          all_good = all_good && ((k % 100 == 0) ? length == 0 : std::abs(length - 1) < 1e-6f);
+        }
+        REQUIRE(all_good);
+      }
+
+      THEN("the bounds can be reduced again from the buffer")
+      {
+        bound_t again_min, again_max;
+        again_min.fill(std::numeric_limits<float>::max());
+        again_max.fill(-std::numeric_limits<float>::max());
+        reduce_bounds(packed.data(), count, 6, again_min, again_max);
+        REQUIRE(again_min == min_bound);
+        REQUIRE(again_max == max_bound);
+      }
+    }
+
+    WHEN("they are packed by the SSE2 kernel, whichever pack_vertices() uses")
+    {
+      std::vector<float> packed(6 * count + 1, -1);
+      std::vector<float> reference(6 * count);
+      pack_vertices_sse2(positions.data(), normals.data(), count, packed.data(),
+                         min_bound, max_bound);
+      pack_vertices_scalar(positions.data(), normals.data(), count, reference.data(),
+                           reference_min, reference_max);
+
+      THEN("they match the plain C++ kernel")
+      {
+        REQUIRE(packed.back() == -1);
+        bool all_good = true;
+        for(size_t k = 0; k < 6 * count; ++k) {
+          all_good = all_good && std::abs(packed[k] - reference[k]) < 1e-6f * std::max(1.f, std::abs(reference[k]));
+        }
+        REQUIRE(all_good);
+        REQUIRE(min_bound == reference_min);
+        REQUIRE(max_bound == reference_max);
+      }
+    }
+
+    WHEN("fewer points are packed than a block holds, or a few more")
+    {
+      THEN("every kernel matches the plain C++ one")
+      {
+        for(size_t few = 0; few <= 17; ++few) {
+          const double* with_and_without[] = {normals.data(), nullptr};
+          for(const double* few_normals: with_and_without) {
+            const size_t entries = few_normals ? 6 : 3;
+            std::vector<float> reference(entries * few);
+            bound_t reference_low = reference_min, reference_high = reference_max;
+            pack_vertices_scalar(positions.data(), few_normals, few, reference.data(),
+                                 reference_low, reference_high);
+            for(auto kernel: {&pack_vertices_sse2, static_cast<decltype(&pack_vertices_sse2)>(&pack_vertices)}) {
+              INFO("points: " << few << ", normals: " << (few_normals != nullptr));
+              std::vector<float> packed(entries * few + 1, -1);
+              bound_t low = reference_min, high = reference_max;
+              kernel(positions.data(), few_normals, few, packed.data(), low, high);
+              REQUIRE(packed.back() == -1);
+              bool all_good = true;
+              for(size_t k = 0; k < entries * few; ++k) {
+                all_good = all_good && std::abs(packed[k] - reference[k]) < 1e-6f * std::max(1.f, std::abs(reference[k]));
+              }
+              REQUIRE(all_good);
+              REQUIRE(low == reference_low);
+              REQUIRE(high == reference_high);
+            }
+          }
+        }
+      }
+    }
+
+    WHEN("only positions are packed")
+    {
+      std::vector<float> packed(3 * count + 1, -1);
+      pack_vertices(positions.data(), nullptr, count, packed.data());
+
+      THEN("they are the positions, converted to floats")
+      {
+        REQUIRE(packed.back() == -1);
+        bool all_good = true;
+        for(size_t k = 0; k < 3 * count; ++k) {
+          all_good = all_good && packed[k] == static_cast<float>(positions[k]);
+        }
+        REQUIRE(all_good);
+      }
+    }
+  }
+}
@@ -0,0 +1,98 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+
+#include <libparacadis/mesh_provider/VertexPacking.h>
+
+#include <chrono>
+#include <format>
+#include <limits>
+#include <vector>
+
+using namespace Mesh;
+
+namespace {
+  /**
+   * Vertices per second of @a kernel,
+   * measured over a few runs on @a count vertices.
+   */
+  template<typename Kernel>
+  double vertices_per_second(size_t count, Kernel&& kernel)
+  {
+    constexpr int runs = 20;
+    const auto start = std::chrono::steady_clock::now();
+    for(int run = 0; run < runs; ++run) {
+      kernel();
+    }
+    const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return runs * count / elapsed.count();
+  }
+}
+
+TEST_CASE("Packing vertices", "[benchmark]")
+{
+  constexpr size_t count = 1 << 20;
+  std::vector<double> positions(3 * count);
+  std::vector<double> normals(3 * count);
+  for(size_t k = 0; k < 3 * count; ++k) {
+    positions[k] = 0.001 * k;
+    normals[k] = 1 + (k % 7);
+  }
+  std::vector<float> out(6 * count);
+  bound_t min_bound, max_bound;
+  min_bound.fill(std::numeric_limits<float>::max());
+  max_bound.fill(-std::numeric_limits<float>::max());
+
+  auto simd = [&] {
+    pack_vertices(positions.data(), normals.data(), count, out.data(), min_bound, max_bound);
+  };
+  auto sse2 = [&] {
+    pack_vertices_sse2(positions.data(), normals.data(), count, out.data(), min_bound, max_bound);
+  };
+  auto scalar = [&] {
+    pack_vertices_scalar(positions.data(), normals.data(), count, out.data(), min_bound, max_bound);
+  };
+
+  BENCHMARK(std::format("1M vertices with normals ({})", packing_instruction_set()))
+  {
+    simd();
+    return out[0];
+  };
+  BENCHMARK("1M vertices with normals (SSE2)")
+  {
+    sse2();
+    return out[0];
+  };
+  BENCHMARK("1M vertices with normals (scalar)")
+  {
+    scalar();
+    return out[0];
+  };
+
+  WARN(std::format("{}: {:.3g} vertices/s, SSE2: {:.3g} vertices/s, scalar: {:.3g} vertices/s",
+                   packing_instruction_set(),
+                   vertices_per_second(count, simd),
+                   vertices_per_second(count, sse2),
+                   vertices_per_second(count, scalar)));
+}
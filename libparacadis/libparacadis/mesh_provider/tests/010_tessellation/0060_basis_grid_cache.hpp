@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/mesh_provider/BasisGridCache.h>
+#include <libparacadis/mesh_provider/GridEvaluator.h>
+
+#include <gismo/gismo.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Mesh;
+
+SCENARIO("Caching basis grids", "[simple]")
+{
+  GIVEN("two spheres with the same basis, and a grid of parameters")
+  {
+    const std::unique_ptr<const iga_geometry_t> sphere{
+        gismo::gsNurbsCreator<real_t>::NurbsSphere(1)};
+    // Same knots and weights: only the control points moved.
+    const std::unique_ptr<const iga_geometry_t> edited{
+        gismo::gsNurbsCreator<real_t>::NurbsSphere(2, 0, 0, 1)};
+    const gismo::gsMatrix<real_t> range = sphere->parameterRange();
+    std::vector<std::vector<real_t>> samples(2);
+    for(int d = 0; d < 2; ++d) {
+      for(int k = 0; k <= 30; ++k) {
+        samples[d].push_back(range(d, 0) + (range(d, 1) - range(d, 0)) * k / 30);
+      }
+    }
+    BasisGridCache cache;
+
+    WHEN("both are evaluated")
+    {
+      const GridEvaluator first{*sphere, samples, cache};
+      const GridEvaluator second{*edited, samples, cache};
+
+      THEN("the basis is evaluated only for the first one")
+      {
+        const auto metrics = cache.getMetrics();
+        REQUIRE(metrics.misses == 1);
+        REQUIRE(metrics.hits == 1);
+        REQUIRE(metrics.entries == 1);
+        REQUIRE(metrics.bytes > 0);
+      }
+
+      THEN("the second one is evaluated as if nothing was cached")
+      {
+        BasisGridCache empty;
+        const GridEvaluator reference{*edited, samples, empty};
+
+        std::vector<float> cached(GridEvaluator::entries * 31 * 31);
+        std::vector<float> expected(cached.size());
+        second.evaluate(0, 31, cached.data());
+        reference.evaluate(0, 31, expected.data());
+        REQUIRE(cached == expected);
+      }
+    }
+
+    WHEN("the samples are different")
+    {
+      const GridEvaluator first{*sphere, samples, cache};
+      samples[1].pop_back();
+      const GridEvaluator second{*sphere, samples, cache};
+
+      THEN("they are different grids")
+      {
+        REQUIRE(cache.getMetrics().misses == 2);
+        REQUIRE(cache.getMetrics().entries == 2);
+      }
+    }
+
+    WHEN("a grid is compared to the basis and samples it is looked up for")
+    {
+      const auto& basis = sphere->basis();
+      const auto* tensor = dynamic_cast<const gismo::gsTensorBasis<2, real_t>*>(
+          basis.isRational() ? &basis.source() : &basis);
+      REQUIRE(tensor);
+      const auto grid = cache.get(*tensor, samples);
+      auto fewer = samples;
+      fewer[0].pop_back();
+
+      THEN("it only fits its own sizes")
+      {
+        REQUIRE(grid->fits(*tensor, samples));
+        REQUIRE(!grid->fits(*tensor, fewer));
+        REQUIRE(cache.getMetrics().collisions == 0);
+      }
+    }
+
+    WHEN("the capacity is smaller than a grid")
+    {
+      cache.setCapacity(1);
+      const GridEvaluator first{*sphere, samples, cache};
+
+      THEN("it is used, but not kept")
+      {
+        REQUIRE(first.isTensor());
+        REQUIRE(cache.getMetrics().entries == 0);
+        REQUIRE(cache.getMetrics().evictions == 1);
+      }
+    }
+  }
+}
@@ -0,0 +1,237 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/mesh_provider/Tessellation.h>
+#include <libparacadis/mesh_provider/TessellationCache.h>
+#include <libparacadis/mesh_provider/VertexCacheOptimizer.h>
+
+#include <gismo/gismo.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+using namespace Mesh;
+
+namespace {
+  using vertex_t = std::array<float, 6>;
+  using triangle_t = std::array<vertex_t, 3>;
+
+  /**
+   * The triangles of all chunks, each one rotated to start
+   * with its smallest vertex (the orientation is kept), sorted.
+   */
+  std::vector<triangle_t> triangle_set(const TessellationResult& result)
+  {
+    std::vector<triangle_t> triangles;
+    for(const auto& chunk: result.chunks) {
+      auto vertex = [&](size_t index) {
+        vertex_t v;
+        std::copy_n(&chunk.vertex[6 * index], 6, v.begin());
+        return v;
+      };
+      for(size_t k = 0; k < chunk.indexes.size(); k += 3) {
+        triangle_t t{vertex(chunk.indexes[k]), vertex(chunk.indexes[k+1]),
+                     vertex(chunk.indexes[k+2])};
+        std::rotate(t.begin(), std::min_element(t.begin(), t.end()), t.end());
+        triangles.push_back(t);
+      }
+    }
+    std::ranges::sort(triangles);
+    return triangles;
+  }
+
+  bool valid_indexes(const TessellationResult& result)
+  {
+    return std::ranges::all_of(result.chunks, [](const MeshChunk& chunk) {
+      const size_t count = chunk.vertex.size() / 6;
+      return std::ranges::all_of(chunk.indexes, [&](auto i) { return i < count; });
+    });
+  }
+}
+
+SCENARIO("Optimizing surfaces for the vertex cache", "[simple]")
+{
+  GIVEN("a sphere tessellated without optimization")
+  {
+    const std::unique_ptr<const iga_geometry_t> sphere{
+        gismo::gsNurbsCreator<real_t>::NurbsSphere(1)};
+    TessellationParameters parameters;
+    parameters.chordalTolerance = 1e-3;
+    const auto plain = tessellate(*sphere, parameters);
+
+    THEN("nothing is reported")
+    {
+      REQUIRE(plain.vertexCache.trianglesBefore == 0);
+      REQUIRE(plain.vertexCache.acmrAfter() == 0);
+    }
+
+    WHEN("it is tessellated with optimization")
+    {
+      parameters.optimizeVertexCache = true;
+      const auto optimized = tessellate(*sphere, parameters);
+      const auto& stats = optimized.vertexCache;
+
+      THEN("fewer vertices are transformed per triangle")
+      {
+        REQUIRE(stats.trianglesBefore == plain.triangleCount());
+        REQUIRE(stats.trianglesAfter == stats.trianglesBefore);
+        REQUIRE(stats.acmrAfter() < stats.acmrBefore());
+        REQUIRE(stats.acmrAfter() < 1);
+        REQUIRE(stats.welded == 0);
+      }
+
+      THEN("it has the same vertices and triangles")
+      {
+        REQUIRE(optimized.chunks.size() == plain.chunks.size());
+        REQUIRE(optimized.vertexCount() == plain.vertexCount());
+        REQUIRE(valid_indexes(optimized));
+        REQUIRE(triangle_set(optimized) == triangle_set(plain));
+      }
+
+      THEN("the measured misses match the chunks")
+      {
+        size_t misses = 0;
+        for(const auto& chunk: optimized.chunks) {
+          misses += cache_misses(chunk.indexes);
+        }
+        REQUIRE(misses == stats.missesAfter);
+      }
+    }
+
+    WHEN("it is tessellated with optimization and welding")
+    {
+      parameters.optimizeVertexCache = true;
+      parameters.weldSeams = true;
+      const auto welded = tessellate(*sphere, parameters);
+      const auto& stats = welded.vertexCache;
+
+      THEN("the seam and the poles share vertices")
+      {
+        REQUIRE(stats.welded > 0);
+        REQUIRE(welded.vertexCount() + stats.welded == plain.vertexCount());
+        REQUIRE(stats.trianglesAfter < stats.trianglesBefore);
+        REQUIRE(welded.triangleCount() == stats.trianglesAfter);
+        REQUIRE(valid_indexes(welded));
+      }
+    }
+
+    WHEN("it is tessellated with optimization through a TessellationCache")
+    {
+      parameters.optimizeVertexCache = true;
+      TessellationCache cache;
+      const auto optimized = cache.tessellate(*sphere, parameters);
+      cache.tessellate(*sphere, parameters);
+
+      THEN("the metrics report it once")
+      {
+        const auto& stats = cache.getMetrics().vertexCache;
+        REQUIRE(stats.trianglesBefore == optimized->vertexCache.trianglesBefore);
+        REQUIRE(stats.missesAfter == optimized->vertexCache.missesAfter);
+        REQUIRE(stats.acmrAfter() < stats.acmrBefore());
+      }
+    }
+  }
+
+  GIVEN("a triangle list in the order of a long grid")
+  {
+    // 100 by 3 vertices: each row is out of the cache when the next one is used.
+    std::vector<std::uint16_t> triangles;
+    constexpr std::uint16_t cols = 100;
+    for(std::uint16_t j = 0; j < 2; ++j) {
+      for(std::uint16_t i = 0; i + 1 < cols; ++i) {
+        const std::uint16_t a = j * cols + i;
+        triangles.insert(triangles.end(), {a, std::uint16_t(a+1), std::uint16_t(a+cols+1)});
+        triangles.insert(triangles.end(), {std::uint16_t(a+cols+1), std::uint16_t(a+cols), a});
+      }
+    }
+
+    THEN("the FIFO cache misses are counted")
+    {
+      // With room for all of them, each vertex is transformed once.
+      REQUIRE(cache_misses(triangles, 3 * cols) == 3 * cols);
+      REQUIRE(cache_misses(triangles, 4) > 3 * cols);
+    }
+  }
+
+  GIVEN("tiny caches")
+  {
+    const std::vector<std::uint16_t> repeated{0, 0, 0};
+    const std::vector<std::uint16_t> alternating{0, 1, 0, 1, 0, 1};
+    const std::vector<std::uint16_t> three{0, 1, 2, 0, 1, 2};
+
+    THEN("a cache of 1 keeps the last vertex")
+    {
+      REQUIRE(cache_misses(repeated, 1) == 1);
+      REQUIRE(cache_misses(alternating, 1) == 6);
+    }
+
+    THEN("a cache of 2 keeps the last two vertices")
+    {
+      REQUIRE(cache_misses(repeated, 2) == 1);
+      REQUIRE(cache_misses(alternating, 2) == 2);
+      REQUIRE(cache_misses(three, 2) == 6);
+      REQUIRE(cache_misses(three, 3) == 3);
+    }
+  }
+
+  GIVEN("two flat strips sharing an edge, with their own vertices")
+  {
+    // All in the plane x = 0, so no coordinate tells the vertices apart alone.
+    constexpr std::uint16_t rows = 50;
+    constexpr std::uint16_t cols = 11;
+    MeshChunk chunk;
+    for(int strip = 0; strip < 2; ++strip) {
+      for(std::uint16_t j = 0; j < rows; ++j) {
+        for(std::uint16_t i = 0; i < cols; ++i) {
+          chunk.vertex.insert(chunk.vertex.end(),
+                              {0, float(strip * (cols - 1) + i), float(j), 1, 0, 0});
+        }
+      }
+      const std::uint16_t base = strip * rows * cols;
+      for(std::uint16_t j = 0; j + 1 < rows; ++j) {
+        for(std::uint16_t i = 0; i + 1 < cols; ++i) {
+          const std::uint16_t a = base + j * cols + i;
+          chunk.indexes.insert(chunk.indexes.end(),
+                               {a, std::uint16_t(a+1), std::uint16_t(a+cols+1),
+                                std::uint16_t(a+cols+1), std::uint16_t(a+cols), a});
+        }
+      }
+    }
+    const size_t triangles = chunk.indexes.size() / 3;
+
+    WHEN("it is optimized with welding")
+    {
+      const auto stats = optimize_vertex_cache(chunk, 6, true);
+
+      THEN("only the shared edge is welded")
+      {
+        REQUIRE(stats.welded == rows);
+        REQUIRE(chunk.vertex.size() / 6 == 2 * rows * cols - rows);
+        REQUIRE(stats.trianglesAfter == triangles);
+      }
+    }
+  }
+}
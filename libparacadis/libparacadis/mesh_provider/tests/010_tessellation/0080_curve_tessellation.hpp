@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/mesh_provider/Tessellation.h>
+#include <libparacadis/mesh_provider/TessellationResult.h>
+
+#include <gismo/gismo.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Mesh;
+
+namespace {
+  /// Lengths of the segments of a curve tessellation (a single line strip).
+  std::vector<real_t> segment_lengths(const TessellationResult& result)
+  {
+    std::vector<real_t> lengths;
+    const auto& vertex = result.chunks.front().vertex;
+    for(size_t k = 3; k < vertex.size(); k += 3) {
+      real_t length2 = 0;
+      for(int d = 0; d < 3; ++d) {
+        length2 += (vertex[k+d] - vertex[k-3+d]) * (vertex[k+d] - vertex[k-3+d]);
+      }
+      lengths.push_back(std::sqrt(length2));
+    }
+    return lengths;
+  }
+}
+
+SCENARIO("Tessellating curves", "[simple]")
+{
+  GIVEN("a rational circle")
+  {
+    const std::unique_ptr<const iga_geometry_t> circle{
+        gismo::gsNurbsCreator<real_t>::NurbsCircle(1)};
+    TessellationParameters parameters;
+    parameters.chordalTolerance = 1e-3;
+
+    WHEN("it is tessellated")
+    {
+      const auto result = tessellate(*circle, parameters);
+
+      THEN("it is a closed strip on the circle")
+      {
+        REQUIRE(result.dimension == 1);
+        REQUIRE(result.chunks.size() == 1);
+        const auto& chunk = result.chunks.front();
+        REQUIRE(chunk.indexes.size() == chunk.vertex.size() / 3);
+        for(size_t k = 0; k < chunk.vertex.size(); k += 3) {
+          const real_t radius = std::hypot(chunk.vertex[k], chunk.vertex[k+1]);
+          REQUIRE(std::abs(radius - 1) < 1e-5);
+          REQUIRE(chunk.vertex[k+2] == 0);
+        }
+        REQUIRE(std::abs(chunk.vertex[0] - chunk.vertex[chunk.vertex.size() - 3]) < 1e-6);
+      }
+
+      THEN("the points are evenly spaced, within the tolerance")
+      {
+        const auto lengths = segment_lengths(result);
+        const auto [shortest, longest] = std::ranges::minmax(lengths);
+        REQUIRE(longest < 1.05 * shortest);
+        // The sagitta of a chord of length c.
+        REQUIRE(1 - std::sqrt(1 - longest * longest / 4) <= parameters.chordalTolerance);
+        // And not much finer than needed.
+        REQUIRE(1 - std::sqrt(1 - longest * longest / 4) > parameters.chordalTolerance / 2);
+      }
+    }
+
+    WHEN("the tolerance is smaller")
+    {
+      const auto coarse = tessellate(*circle, parameters);
+      parameters.chordalTolerance /= 4;
+      const auto fine = tessellate(*circle, parameters);
+
+      THEN("the curve has about twice as many points")
+      {
+        const real_t ratio = real_t(fine.vertexCount()) / coarse.vertexCount();
+        REQUIRE(ratio > 1.8);
+        REQUIRE(ratio < 2.2);
+      }
+    }
+  }
+
+  GIVEN("a straight polyline with many knot spans")
+  {
+    gismo::gsKnotVector<real_t> knots(0, 1, 8, 2);
+    gismo::gsMatrix<real_t> coefs(10, 3);
+    for(index_t k = 0; k < 10; ++k) {
+      coefs.row(k) << k, 2 * k, 0;
+    }
+    const gismo::gsBSpline<real_t> line(knots, coefs);
+    TessellationParameters parameters;
+    parameters.minSegmentsPerSpan = 4;
+
+    THEN("only its ends are kept")
+    {
+      const auto result = tessellate(line, parameters);
+      REQUIRE(result.vertexCount() == 2);
+      REQUIRE(result.chunks.front().indexes.size() == 2);
+    }
+  }
+}
+
+SCENARIO("Simplifying polylines", "[simple]")
+{
+  GIVEN("a zigzag with small and large teeth")
+  {
+    // Teeth of height 0.01 and, in the middle, 1.
+    std::vector<float> points;
+    for(int k = 0; k <= 10; ++k) {
+      points.insert(points.end(), {float(k), (k % 2) ? (k == 5 ? 1.f : 0.01f) : 0.f, 0.f});
+    }
+
+    THEN("the teeth below the tolerance are dropped")
+    {
+      const auto kept = simplify_polyline(points.data(), 11, 0.1);
+      REQUIRE(kept == std::vector<std::uint32_t>{0, 4, 5, 6, 10});
+    }
+
+    THEN("with a small tolerance, everything is kept")
+    {
+      REQUIRE(simplify_polyline(points.data(), 11, 1e-3).size() == 11);
+    }
+
+    THEN("short polylines are kept")
+    {
+      REQUIRE(simplify_polyline(points.data(), 2, 10).size() == 2);
+      REQUIRE(simplify_polyline(points.data(), 0, 10).empty());
+    }
+  }
+}
+
+SCENARIO("Merging curves", "[simple]")
+{
+  GIVEN("the tessellations of two circles")
+  {
+    const std::unique_ptr<const iga_geometry_t> small{
+        gismo::gsNurbsCreator<real_t>::NurbsCircle(1)};
+    const std::unique_ptr<const iga_geometry_t> large{
+        gismo::gsNurbsCreator<real_t>::NurbsCircle(3, 5, 0)};
+    TessellationParameters parameters;
+    parameters.chordalTolerance = 1e-3;
+    const std::vector<std::shared_ptr<const TessellationResult>> curves{
+        std::make_shared<const TessellationResult>(tessellate(*small, parameters)),
+        std::make_shared<const TessellationResult>(tessellate(*large, parameters))};
+
+    WHEN("they are merged")
+    {
+      const auto merged = merge_curves(curves);
+
+      THEN("they are a single line list")
+      {
+        REQUIRE(merged.dimension == 1);
+        REQUIRE(merged.lineList);
+        REQUIRE(merged.chunks.size() == 1);
+        REQUIRE(merged.vertexCount() == curves[0]->vertexCount() + curves[1]->vertexCount());
+
+        const auto& chunk = merged.chunks.front();
+        REQUIRE(chunk.indexes.size()
+                == 2 * (curves[0]->vertexCount() - 1 + curves[1]->vertexCount() - 1));
+        // The first segment of the second circle.
+        const auto first = curves[0]->vertexCount();
+        REQUIRE(chunk.indexes[2 * (first - 1)] == first);
+        REQUIRE(chunk.indexes[2 * (first - 1) + 1] == first + 1);
+      }
+
+      THEN("the bounds cover both")
+      {
+        const auto& chunk = merged.chunks.front();
+        REQUIRE(chunk.min_bound[0] < -0.99f);
+        REQUIRE(chunk.max_bound[0] > 7.99f);
+        REQUIRE(chunk.max_bound[1] > 2.99f);
+        REQUIRE(chunk.indexHash != 0);
+      }
+
+      THEN("merging again gives the same line list")
+      {
+        const std::vector<std::shared_ptr<const TessellationResult>> again{
+            std::make_shared<const TessellationResult>(merged)};
+        const auto remerged = merge_curves(again);
+        REQUIRE(remerged.chunks.front().indexes == merged.chunks.front().indexes);
+      }
+    }
+  }
+}
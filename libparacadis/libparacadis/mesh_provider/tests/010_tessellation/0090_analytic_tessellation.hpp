@@ -0,0 +1,157 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/mesh_provider/AnalyticTessellation.h>
+#include <libparacadis/mesh_provider/TessellationResult.h>
+
+#include <gismo/gismo.h>
+
+#include <array>
+#include <cmath>
+#include <memory>
+
+using namespace Mesh;
+
+namespace {
+  real_t distance(const float* p, const std::array<real_t, 3>& q)
+  {
+    return std::hypot(p[0] - q[0], p[1] - q[1], p[2] - q[2]);
+  }
+}
+
+SCENARIO("Tessellating analytic primitives in closed form", "[simple]")
+{
+  TessellationParameters parameters;
+  parameters.chordalTolerance = 1e-3;
+
+  GIVEN("a sphere")
+  {
+    const Document::AnalyticSphere sphere{{1, 2, 3}, 2};
+
+    WHEN("it is tessellated in closed form")
+    {
+      const auto result = tessellate(Document::AnalyticShape{sphere}, parameters);
+
+      THEN("vertices are on the sphere, with radial unit normals")
+      {
+        REQUIRE(result.dimension == 2);
+        REQUIRE(result.triangleCount() > 0);
+        for(const auto& chunk: result.chunks) {
+          for(size_t k = 0; k < chunk.vertex.size(); k += 6) {
+            const float* p = &chunk.vertex[k];
+            const float* n = &chunk.vertex[k+3];
+            REQUIRE(std::abs(distance(p, sphere.center) - sphere.radius) < 1e-5);
+            for(int d = 0; d < 3; ++d) {
+              REQUIRE(std::abs(n[d] - (p[d] - sphere.center[d]) / sphere.radius) < 1e-5);
+            }
+          }
+        }
+      }
+
+      THEN("triangles are within the chordal tolerance")
+      {
+        for(const auto& chunk: result.chunks) {
+          for(size_t t = 0; t < chunk.indexes.size(); t += 3) {
+            std::array<real_t, 3> centroid{0, 0, 0};
+            for(int v = 0; v < 3; ++v) {
+              for(int d = 0; d < 3; ++d) {
+                centroid[d] += chunk.vertex[6 * chunk.indexes[t+v] + d] / 3;
+              }
+            }
+            const real_t depth = sphere.radius
+                                 - std::hypot(centroid[0] - sphere.center[0],
+                                              centroid[1] - sphere.center[1],
+                                              centroid[2] - sphere.center[2]);
+            REQUIRE(depth < parameters.chordalTolerance);
+          }
+        }
+      }
+    }
+
+    WHEN("analytic shapes are disabled")
+    {
+      const std::unique_ptr<const iga_geometry_t> nurbs{
+          gismo::gsNurbsCreator<real_t>::NurbsSphere(2, 1, 2, 3)};
+      const Document::AnalyticShape shape{sphere};
+      parameters.analyticShapes = false;
+
+      THEN("the NURBS is tessellated instead")
+      {
+        const auto result = tessellate(*nurbs, parameters, {}, &shape);
+        REQUIRE(result.vertexCount() == tessellate(*nurbs, parameters).vertexCount());
+      }
+    }
+  }
+
+  GIVEN("a circle")
+  {
+    const real_t s = std::sqrt(0.5);
+    const Document::AnalyticCircle circle{{1, 0, 0}, {0, s, s}, {1, 0, 0}, 3};
+
+    WHEN("it is tessellated in closed form")
+    {
+      const auto result = tessellate(Document::AnalyticShape{circle}, parameters);
+
+      THEN("it is a closed strip on the circle, with short enough chords")
+      {
+        REQUIRE(result.dimension == 1);
+        REQUIRE(result.chunks.size() == 1);
+        const auto& vertex = result.chunks.front().vertex;
+        REQUIRE(vertex.size() > 3 * 4);
+        for(size_t k = 0; k < vertex.size(); k += 3) {
+          const float* p = &vertex[k];
+          REQUIRE(std::abs(distance(p, circle.center) - circle.radius) < 1e-5);
+          // In the plane.
+          real_t height = 0;
+          for(int d = 0; d < 3; ++d) {
+            height += (p[d] - circle.center[d]) * circle.normal[d];
+          }
+          REQUIRE(std::abs(height) < 1e-5);
+          if(k > 0) {
+            const real_t chord = std::hypot(p[0] - p[-3], p[1] - p[-2], p[2] - p[-1]);
+            const real_t sagitta = circle.radius
+                                   - std::sqrt(circle.radius * circle.radius - chord * chord / 4);
+            REQUIRE(sagitta < parameters.chordalTolerance * (1 + 1e-3));
+          }
+        }
+        // Starts at xdir and closes exactly.
+        REQUIRE(std::abs(vertex[0] - 4) < 1e-6);
+        for(int d = 0; d < 3; ++d) {
+          REQUIRE(vertex[d] == vertex[vertex.size() - 3 + d]);
+        }
+      }
+    }
+  }
+
+  GIVEN("the parameters")
+  {
+    THEN("arcs are split in at least minSegmentsPerSpan per quarter of a turn")
+    {
+      parameters.minSegmentsPerSpan = 2;
+      REQUIRE(arc_segments(2 * 3.14159265358979, 10, parameters) == 8);
+      parameters.maxSegmentsPerSpan = 3;
+      REQUIRE(arc_segments(3.14159265358979, 1e-6, parameters) == 6);
+    }
+  }
+}
@@ -0,0 +1,223 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/mesh_provider/TessellationCache.h>
+#include <libparacadis/mesh_provider/TessellationDiskCache.h>
+#include <libparacadis/mesh_provider/TessellationResult.h>
+
+#include <gismo/gismo.h>
+
+#include <cstring>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <memory>
+#include <random>
+
+using namespace Mesh;
+
+namespace {
+  /// A new directory, removed with the object.
+  struct TemporaryDirectory
+  {
+    std::filesystem::path path = std::filesystem::temp_directory_path()
+                                 / std::format("paracadis-test-{:x}", std::random_device{}());
+    ~TemporaryDirectory()
+    {
+      std::error_code error;
+      std::filesystem::remove_all(path, error);
+    }
+  };
+
+  size_t files_in(const std::filesystem::path& directory)
+  {
+    return std::distance(std::filesystem::directory_iterator(directory),
+                         std::filesystem::directory_iterator());
+  }
+}
+
+SCENARIO("Keeping tessellations on disk", "[simple]")
+{
+  TemporaryDirectory directory;
+  const std::shared_ptr<const iga_geometry_t> sphere{
+      gismo::gsNurbsCreator<real_t>::NurbsSphere(1)};
+  const auto hash = geometry_hash(*sphere);
+  TessellationParameters parameters;
+  parameters.vertexFormat = VertexFormat::COMPACT;
+  parameters.optimizeVertexCache = true;
+  const auto tessellation = tessellate(*sphere, parameters);
+
+  GIVEN("a disk cache with a tessellation stored")
+  {
+    auto disk = std::make_shared<TessellationDiskCache>(directory.path);
+    disk->store(hash, parameters, tessellation);
+    REQUIRE(disk->getMetrics().files == 1);
+
+    THEN("a new disk cache on the same directory loads it back, unchanged")
+    {
+      TessellationDiskCache reopened{directory.path};
+      REQUIRE(reopened.getMetrics().files == 1);
+      const auto loaded = reopened.load(hash, parameters);
+      REQUIRE(loaded);
+      REQUIRE(loaded->dimension == tessellation.dimension);
+      REQUIRE(loaded->vertexCache.missesAfter == tessellation.vertexCache.missesAfter);
+      REQUIRE(loaded->frame == tessellation.frame);
+      REQUIRE(loaded->chunks.size() == tessellation.chunks.size());
+      for(size_t k = 0; k < loaded->chunks.size(); ++k) {
+        const auto& a = loaded->chunks[k];
+        const auto& b = tessellation.chunks[k];
+        REQUIRE(a.vertex == b.vertex);
+        REQUIRE(a.compactVertex.size() == b.compactVertex.size());
+        REQUIRE(std::memcmp(a.compactVertex.data(), b.compactVertex.data(), a.vertexBytes()) == 0);
+        REQUIRE(a.indexes == b.indexes);
+        REQUIRE(a.wideIndexes == b.wideIndexes);
+        REQUIRE(a.blockHashes == b.blockHashes);
+        REQUIRE(a.indexHash == b.indexHash);
+        REQUIRE(a.min_bound == b.min_bound);
+        REQUIRE(a.max_bound == b.max_bound);
+      }
+      REQUIRE(reopened.getMetrics().hits == 1);
+    }
+
+    THEN("other parameters miss")
+    {
+      auto other = parameters;
+      other.chordalTolerance /= 2;
+      REQUIRE(!disk->load(hash, other));
+      other = parameters;
+      other.vertexFormat = VertexFormat::FLOAT;
+      REQUIRE(!disk->load(hash, other));
+      REQUIRE(!disk->load(hash + 1, parameters));
+      REQUIRE(disk->getMetrics().misses == 3);
+    }
+
+    WHEN("the file is damaged")
+    {
+      const auto file = std::filesystem::directory_iterator(directory.path)->path();
+      std::filesystem::resize_file(file, std::filesystem::file_size(file) / 2);
+
+      THEN("it misses, and the file is removed")
+      {
+        REQUIRE(!disk->load(hash, parameters));
+        REQUIRE(disk->getMetrics().invalidated == 1);
+        REQUIRE(files_in(directory.path) == 0);
+        REQUIRE(disk->getMetrics().bytes == 0);
+      }
+    }
+
+    WHEN("the file is of another version")
+    {
+      const auto file = std::filesystem::directory_iterator(directory.path)->path();
+      {
+        std::fstream stream(file, std::ios::binary | std::ios::in | std::ios::out);
+        stream.seekp(4);
+        const std::uint32_t version = TessellationDiskCache::format_version + 1;
+        stream.write(reinterpret_cast<const char*>(&version), sizeof(version));
+      }
+
+      THEN("it misses, and the file is removed")
+      {
+        REQUIRE(!disk->load(hash, parameters));
+        REQUIRE(files_in(directory.path) == 0);
+      }
+    }
+
+    WHEN("the capacity is exceeded")
+    {
+      const size_t one = disk->getMetrics().bytes;
+      disk->setCapacity(2 * one + one / 2);
+      auto other = parameters;
+      other.weldSeams = true;
+      disk->store(hash, other, tessellation);
+      // The first one is used: the second one is the least recently used.
+      REQUIRE(disk->load(hash, parameters));
+      other.analyticShapes = false;
+      disk->store(hash, other, tessellation);
+
+      THEN("the least recently used files are removed")
+      {
+        REQUIRE(disk->getMetrics().evictions == 1);
+        REQUIRE(files_in(directory.path) == 2);
+        REQUIRE(disk->load(hash, parameters));
+        REQUIRE(disk->load(hash, other));
+      }
+    }
+  }
+
+  GIVEN("a tessellation cache with a disk cache")
+  {
+    TessellationCache cache;
+    cache.setDiskCache(std::make_shared<TessellationDiskCache>(directory.path));
+    cache.tessellate(*sphere, parameters);
+
+    THEN("the tessellation is queued, not written right away")
+    {
+      REQUIRE(cache.getDiskCache()->getMetrics().queued == 1);
+      REQUIRE(cache.getDiskCache()->getMetrics().stores == 0);
+    }
+
+    WHEN("a geometry being edited is tessellated")
+    {
+      auto other = parameters;
+      other.chordalTolerance /= 2;
+      cache.tessellate(*sphere, other, {}, nullptr, false);
+
+      THEN("it is not queued")
+      {
+        REQUIRE(cache.getDiskCache()->getMetrics().queued == 1);
+      }
+    }
+
+    WHEN("the disk cache is released with its queue")
+    {
+      cache.setDiskCache(nullptr);
+
+      THEN("the queue is written")
+      {
+        REQUIRE(files_in(directory.path) == 1);
+      }
+    }
+
+    WHEN("the queue is flushed, and the memory emptied, as when a document is reopened")
+    {
+      cache.getDiskCache()->flush();
+      REQUIRE(cache.getDiskCache()->getMetrics().stores == 1);
+      REQUIRE(cache.getDiskCache()->getMetrics().queued == 0);
+
+      TessellationCache reopened;
+      auto disk = std::make_shared<TessellationDiskCache>(directory.path);
+      reopened.setDiskCache(disk);
+      const auto result = reopened.tessellate(*sphere, parameters);
+
+      THEN("the tessellation is read from disk, and kept in memory")
+      {
+        REQUIRE(result);
+        REQUIRE(result->vertexCount() == tessellation.vertexCount());
+        REQUIRE(disk->getMetrics().hits == 1);
+        REQUIRE(disk->getMetrics().queued == 0);
+        REQUIRE(reopened.getMetrics().entries == 1);
+      }
+    }
+  }
+}
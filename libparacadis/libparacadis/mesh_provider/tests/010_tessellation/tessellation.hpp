@@ -0,0 +1,34 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <libparacadis/mesh_provider/TessellationResult.h>
+
+#include "0010_tessellation_result.hpp"
+#include "0020_tessellation_benchmark.hpp"
+#include "0030_grid_evaluator.hpp"
+#include "0040_vertex_packing.hpp"
+#include "0050_packing_benchmark.hpp"
+#include "0060_basis_grid_cache.hpp"
+#include "0070_vertex_cache.hpp"
+#include "0080_curve_tessellation.hpp"
+#include "0090_analytic_tessellation.hpp"
+#include "0100_tessellation_disk_cache.hpp"
@@ -0,0 +1,168 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/base/document_tree/DocumentTree.h>
+#include <libparacadis/base/expected_behaviour/SharedPtrWrap.h>
+#include <libparacadis/base/geometric_primitives/coordinate_system/DeferenceableCoordinateSystem.h>
+#include <libparacadis/base/geometric_primitives/spheres.h>
+#include <libparacadis/mesh_provider/DocumentExporter.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
+#include <string>
+
+using namespace Document;
+using namespace Mesh;
+
+namespace {
+  template<typename T>
+  T read_at(const std::string& data, size_t offset)
+  {
+    T value;
+    std::memcpy(&value, data.data() + offset, sizeof(T));
+    return value;
+  }
+
+  size_t count_lines(const std::string& text, const std::string& prefix)
+  {
+    size_t count = 0;
+    std::istringstream lines(text);
+    for(std::string line; std::getline(lines, line); ) {
+      count += line.starts_with(prefix);
+    }
+    return count;
+  }
+}
+
+SCENARIO("Exporting a document to mesh files", "[simple]")
+{
+  GIVEN("a sphere in the document, and another one in a displaced container")
+  {
+    auto document = SharedPtr<DocumentTree>::make_shared();
+    document->addElement(SharedPtrWrap<SphereCenterRadius2>(Point(0, 0, 0), Real(1)));
+
+    auto container = SharedPtr<Container>::make_shared();
+    container->setCoordinates(SharedPtrWrap<DeferenceableCoordinateSystemXY>(Point(10, 0, 0)));
+    container->addElement(SharedPtrWrap<SphereCenterRadius2>(Point(0, 0, 0), Real(1)));
+    document->addContainer(container);
+
+    TessellationParameters parameters;
+    parameters.chordalTolerance = 1e-2;
+
+    WHEN("it is exported to STL")
+    {
+      std::stringstream out;
+      const auto metrics = DocumentExporter{ExportFormat::STL, parameters}
+                               .exportDocument(*document, out);
+      const auto data = out.str();
+
+      THEN("every triangle is written, and counted in the header")
+      {
+        REQUIRE(metrics.geometries == 2);
+        REQUIRE(metrics.skipped == 0);
+        REQUIRE(metrics.triangles > 0);
+        REQUIRE(read_at<std::uint32_t>(data, 80) == metrics.triangles);
+        REQUIRE(data.size() == 84 + 50 * metrics.triangles);
+        REQUIRE(metrics.bytes == data.size());
+      }
+
+      THEN("the vertices are on one of the spheres")
+      {
+        bool all_good = true;
+        size_t displaced = 0;
+        for(size_t t = 0; t < metrics.triangles; ++t) {
+          for(size_t v = 1; v <= 3; ++v) {
+            const size_t offset = 84 + 50 * t + 12 * v;
+            const float x = read_at<float>(data, offset);
+            const float y = read_at<float>(data, offset + 4);
+            const float z = read_at<float>(data, offset + 8);
+            const bool is_displaced = x > 5;
+            displaced += is_displaced;
+            const float radius = std::hypot(is_displaced ? x - 10 : x, y, z);
+            all_good = all_good && std::abs(radius - 1) < 1e-4;
+          }
+        }
+        REQUIRE(all_good);
+        REQUIRE(displaced == 3 * metrics.triangles / 2);
+      }
+    }
+
+    WHEN("it is exported to PLY")
+    {
+      std::stringstream out;
+      const auto metrics = DocumentExporter{ExportFormat::PLY, parameters}
+                               .exportDocument(*document, out);
+      const auto data = out.str();
+
+      THEN("the header has the counts, and the faces follow the vertices")
+      {
+        const auto header_end = data.find("end_header\n");
+        REQUIRE(header_end != std::string::npos);
+        const auto header = data.substr(0, header_end);
+        REQUIRE(header.find("element vertex " + std::to_string(metrics.vertices)) != std::string::npos);
+        REQUIRE(header.find("element face " + std::to_string(metrics.triangles)) != std::string::npos);
+
+        const size_t body = header_end + std::string("end_header\n").size();
+        REQUIRE(data.size() == body + 24 * metrics.vertices + 13 * metrics.triangles);
+
+        const size_t first_face = body + 24 * metrics.vertices;
+        REQUIRE(read_at<std::uint8_t>(data, first_face) == 3);
+        bool all_good = true;
+        for(size_t f = 0; f < metrics.triangles; ++f) {
+          for(size_t k = 0; k < 3; ++k) {
+            all_good = all_good
+                && read_at<std::uint32_t>(data, first_face + 13 * f + 1 + 4 * k) < metrics.vertices;
+          }
+        }
+        REQUIRE(all_good);
+      }
+    }
+
+    WHEN("it is exported to OBJ, with different windows")
+    {
+      std::stringstream out;
+      DocumentExporter exporter{ExportFormat::OBJ, parameters};
+      const auto metrics = exporter.exportDocument(*document, out);
+      std::stringstream one_at_a_time;
+      exporter.setWindow(1);
+      exporter.exportDocument(*document, one_at_a_time);
+
+      THEN("there is a line for each vertex, normal and triangle")
+      {
+        const auto text = out.str();
+        REQUIRE(count_lines(text, "o ") == 2);
+        REQUIRE(count_lines(text, "v ") == metrics.vertices);
+        REQUIRE(count_lines(text, "vn ") == metrics.vertices);
+        REQUIRE(count_lines(text, "f ") == metrics.triangles);
+      }
+
+      THEN("the output does not depend on the window")
+      {
+        REQUIRE(out.str() == one_at_a_time.str());
+      }
+    }
+  }
+}
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2025 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <libparacadis/mesh_provider/MeshMemoryManager.h>
+
+#include <memory>
+#include <vector>
+
+using namespace Mesh;
+
+namespace {
+  /**
+   * A mesh with no GPU: it only reports what it would hold.
+   */
+  class StubMesh : public ManagedMesh
+  {
+  public:
+    explicit StubMesh(MeshMemoryManager& _manager) : manager(_manager) {}
+
+    MeshMemoryUsage getMemoryUsage() const override { return usage; }
+    std::uint64_t   getLastRendered() const override { return lastRendered; }
+
+    void unload() override
+    {
+      ++unloads;
+      upload(0);
+    }
+
+    void upload(size_t gpu_bytes)
+    {
+      usage.gpuBytes = gpu_bytes;
+      manager.report(this, usage);
+      render();
+    }
+
+    void render() { lastRendered = manager.getFrame(); }
+
+    MeshMemoryManager& manager;
+    MeshMemoryUsage    usage;
+    std::uint64_t      lastRendered = 0;
+    int                unloads = 0;
+  };
+}
+
+SCENARIO("Keeping meshes within a GPU budget", "[simple]")
+{
+  GIVEN("three meshes of 100 bytes, last rendered in different frames")
+  {
+    MeshMemoryManager manager;
+    manager.setGpuBudget(1000);
+    std::vector<std::shared_ptr<StubMesh>> meshes;
+    for(int k = 0; k < 3; ++k) {
+      const auto& mesh = meshes.emplace_back(std::make_shared<StubMesh>(manager));
+      manager.add(mesh);
+      mesh->upload(100);
+    }
+    REQUIRE(manager.getTotal().gpuBytes == 300);
+
+    // The second one was rendered longer ago, then the first one.
+    for(const int k: {1, 0, 2}) {
+      manager.frameStarted();
+      meshes[k]->render();
+    }
+    manager.frameStarted();
+    manager.frameStarted();
+
+    WHEN("they fit the budget")
+    {
+      manager.enforce();
+
+      THEN("nothing is unloaded")
+      {
+        for(const auto& mesh: meshes) {
+          REQUIRE(mesh->unloads == 0);
+        }
+      }
+    }
+
+    WHEN("they exceed it by less than a mesh")
+    {
+      manager.setGpuBudget(250);
+      manager.enforce();
+
+      THEN("the one rendered longer ago is unloaded")
+      {
+        REQUIRE(meshes[1]->unloads == 1);
+        REQUIRE(meshes[0]->unloads == 0);
+        REQUIRE(meshes[2]->unloads == 0);
+        REQUIRE(manager.getTotal().gpuBytes == 200);
+      }
+    }
+
+    WHEN("they exceed it by more than a mesh")
+    {
+      manager.setGpuBudget(150);
+      manager.enforce();
+
+      THEN("the ones rendered longer ago are unloaded, in order")
+      {
+        REQUIRE(meshes[1]->unloads == 1);
+        REQUIRE(meshes[0]->unloads == 1);
+        REQUIRE(meshes[2]->unloads == 0);
+        REQUIRE(manager.getTotal().gpuBytes == 100);
+      }
+    }
+
+    WHEN("one is rendered in the last frame, and nothing fits")
+    {
+      meshes[1]->render();
+      manager.frameStarted();
+      manager.setGpuBudget(0);
+      manager.enforce();
+
+      THEN("only the ones out of view are unloaded")
+      {
+        REQUIRE(meshes[1]->unloads == 0);
+        REQUIRE(meshes[0]->unloads == 1);
+        REQUIRE(meshes[2]->unloads == 1);
+        REQUIRE(manager.getTotal().gpuBytes == 100);
+      }
+    }
+
+    WHEN("one is uploaded in this frame, and nothing fits")
+    {
+      meshes[1]->unload();
+      meshes[1]->upload(100);
+      manager.setGpuBudget(0);
+      manager.enforce();
+
+      THEN("it is not unloaded before it has a chance to be rendered")
+      {
+        REQUIRE(meshes[1]->unloads == 1);
+        REQUIRE(meshes[0]->unloads == 1);
+        REQUIRE(meshes[2]->unloads == 1);
+        REQUIRE(manager.getTotal().gpuBytes == 100);
+      }
+    }
+
+    WHEN("one is removed")
+    {
+      manager.remove(meshes[0].get());
+
+      THEN("it is not counted anymore")
+      {
+        REQUIRE(manager.getTotal().gpuBytes == 200);
+      }
+    }
+  }
+}
@@ -26,6 +26,7 @@
 #include "MeshNode.h"
 
 #include <libparacadis/base/expected_behaviour/CycleGuard.h>
+#include <libparacadis/mesh_provider/CurveBatch.h>
 #include <libparacadis/mesh_provider/MeshProvider.h>
 
 #include <cassert>
@@ -33,11 +34,35 @@
 #include <iostream>
 
 #include <OGRE/OgreEntity.h>
+#include <OGRE/OgreMaterialManager.h>
 #include <OGRE/OgreQuaternion.h>
 #include <OGRE/OgreSceneManager.h>
 
 namespace SceneGraph
 {
+  namespace {
+    /**
+     * A copy of the material that does not cull back faces.
+     *
+     * Surfaces are usually open and their tessellations
+     * have one face per triangle.
+     */
+    std::string two_sided_material(const std::string& name)
+    {
+      auto& manager = Ogre::MaterialManager::getSingleton();
+      const auto two_sided_name = name + "/TwoSided";
+      if(!manager.getByName(two_sided_name)) {
+        auto original = manager.getByName(name);
+        if(!original) {
+          return name;
+        }
+        auto two_sided = original->clone(two_sided_name);
+        two_sided->setCullingMode(Ogre::CULL_NONE);
+        two_sided->setManualCullingMode(Ogre::MANUAL_CULL_NONE);
+      }
+      return two_sided_name;
+    }
+  }
 
   SharedPtr<ContainerNode>
   ContainerNode::create_root_node(const SharedPtr<SceneRoot>& scene_root,
@@ -280,7 +305,8 @@ namespace SceneGraph
     if(!scene) {
       return;
     }
-    auto mesh_provider = Mesh::MeshProvider::make_shared(geo, scene->getQueue());
+    auto mesh_provider = Mesh::MeshProvider::make_shared(
+        geo, scene->getQueue(), scene->getTessellationParameters());
     auto temp_mesh_node = MeshNode::make_shared(std::move(mesh_provider));
 
     { // Scoped lock.
@@ -298,13 +324,22 @@ namespace SceneGraph
       gate->emplace(geo.get(), new_mesh_node);
     }
 
+    if(new_mesh_node->isCurve()) {
+      // Drawn with the other curves of the container.
+      new_mesh_node->addToBatch(getCurveBatch(scene_root));
+      return;
+    }
+
+    new_mesh_node->setVisible(true);
     auto mesh = new_mesh_node->getOgreMesh();
     auto mesh_entity = scene_root->sceneManager->createEntity(mesh.sliced());
-    mesh_entity->setMaterialName("WoodPallet");
+    mesh_entity->setMaterialName(two_sided_material("WoodPallet"));
 
     auto ogre_node = ogreNodeWeak.lock();
     assert(ogre_node);
-    ogre_node->attachObject(mesh_entity);
+    // A node of its own: it scales the compact vertices of the mesh.
+    ogre_node->createChildSceneNode()->attachObject(mesh_entity);
+    new_mesh_node->trackEntity(mesh_entity);
   }
 
   void ContainerNode::removeMesh(SharedPtr<geometry_t> geo)
@@ -317,6 +352,41 @@ namespace SceneGraph
     Threads::WriterGate gate{scene_root->meshNodes};
     auto nh = gate->extract(geo.get());
     assert(nh && "Nothing extracted.ß");
+    if(nh && nh.mapped()->isCurve()) {
+      std::scoped_lock lock{curveBatchMutex};
+      if(curveBatch) {
+        nh.mapped()->removeFromBatch(curveBatch);
+      }
+      return;
+    }
+    if(nh && !gate->contains(geo.get())) {
+      nh.mapped()->setVisible(false);
+    }
+  }
+
+  SharedPtr<Mesh::CurveBatch>
+  ContainerNode::getCurveBatch(const SharedPtr<SceneRoot>& scene_root)
+  {
+    std::scoped_lock lock{curveBatchMutex};
+    if(curveBatch) {
+      return curveBatch;
+    }
+    curveBatch = SharedPtr<Mesh::CurveBatch>::from_pointer(
+        new Mesh::CurveBatch(scene_root->getTessellationParameters()));
+    curveBatch->setVisible(true);
+    {
+      std::scoped_lock batches_lock{scene_root->curveBatchesMutex};
+      scene_root->curveBatches.push_back(curveBatch);
+    }
+
+    auto batch_entity = scene_root->sceneManager->createEntity(curveBatch->getOgreMesh().sliced());
+    batch_entity->setMaterialName(two_sided_material("WoodPallet"));
+    auto ogre_node = ogreNodeWeak.lock();
+    assert(ogre_node);
+    // A node of its own, like meshes.
+    ogre_node->createChildSceneNode()->attachObject(batch_entity);
+    curveBatch->trackEntity(batch_entity);
+    return curveBatch;
   }
 
   namespace {
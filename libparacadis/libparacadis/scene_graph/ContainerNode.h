@@ -25,11 +25,16 @@
 #include "forwards.h"
 
 #include <memory>
+#include <mutex>
 
 #include <libparacadis/base/expected_behaviour/CycleGuard.h>
 #include <libparacadis/base/expected_behaviour/SharedPtr.h>
 #include <libparacadis/base/threads/safe_structs/ThreadSafeMap.h>
 
+namespace Mesh {
+  class CurveBatch;
+}
+
 namespace SceneGraph
 {
   /**
@@ -102,5 +107,15 @@ namespace SceneGraph
     template<typename Key, typename Val>
     using map_t = Threads::SafeStructs::ThreadSafeUnorderedMap<Key, Val>;
     map_t<container_t*, SharedPtr<ContainerNode>> containerNodes;
+
+    /**
+     * The curves of this container, drawn together.
+     * Created (and attached to the OGRE node) with the first curve.
+     */
+    /// @{
+    std::mutex                  curveBatchMutex;
+    SharedPtr<Mesh::CurveBatch> curveBatch;
+    /// @}
+    SharedPtr<Mesh::CurveBatch> getCurveBatch(const SharedPtr<SceneRoot>& scene_root);
   };
 }
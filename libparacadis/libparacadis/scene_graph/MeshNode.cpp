@@ -43,4 +43,34 @@ namespace SceneGraph
     return meshProvider->getOgreMesh();
   }
 
+  void MeshNode::setVisible(bool visible)
+  {
+    meshProvider->setVisible(visible);
+  }
+
+  void MeshNode::trackEntity(Ogre::MovableObject* entity)
+  {
+    meshProvider->trackEntity(entity);
+  }
+
+  void MeshNode::setTessellationParameters(const Mesh::TessellationParameters& parameters)
+  {
+    meshProvider->setTessellationParameters(parameters);
+  }
+
+  bool MeshNode::isCurve() const
+  {
+    return meshProvider->isCurve();
+  }
+
+  void MeshNode::addToBatch(const SharedPtr<Mesh::CurveBatch>& batch)
+  {
+    meshProvider->addToBatch(batch);
+  }
+
+  void MeshNode::removeFromBatch(const SharedPtr<Mesh::CurveBatch>& batch)
+  {
+    meshProvider->removeFromBatch(batch);
+  }
+
 }
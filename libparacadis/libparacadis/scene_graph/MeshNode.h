@@ -29,6 +29,7 @@
 
 namespace Ogre {
   class Mesh;
+  class MovableObject;
 }
 
 namespace SceneGraph
@@ -43,6 +44,13 @@ namespace SceneGraph
     static SharedPtr<MeshNode> make_shared(SharedPtr<Mesh::MeshProvider> mesh_provider);
 
     SharedPtr<Ogre::Mesh> getOgreMesh();
+    void setVisible(bool visible);
+    void trackEntity(Ogre::MovableObject* entity);
+    void setTessellationParameters(const Mesh::TessellationParameters& parameters);
+
+    bool isCurve() const;
+    void addToBatch(const SharedPtr<Mesh::CurveBatch>& batch);
+    void removeFromBatch(const SharedPtr<Mesh::CurveBatch>& batch);
 
   private:
     MeshNode(SharedPtr<Mesh::MeshProvider> mesh_provider);
@@ -25,6 +25,10 @@
 #include "SceneRoot.h"
 
 #include "ContainerNode.h"
+#include "MeshNode.h"
+
+#include <libparacadis/mesh_provider/CurveBatch.h>
+#include <libparacadis/mesh_provider/MeshMemoryManager.h>
 
 #include <cassert>
 
@@ -47,9 +51,95 @@ namespace SceneGraph
                            const SharedPtr<Document::DocumentTree>& document)
   {
     self->self = self;
+    self->documentWeak = document;
+    document->tessellation_changed_sig.connect(
+        document, self->signalQueue, self, &SceneRoot::slotTessellationChanged);
     self->rootContainer = ContainerNode::create_root_node(self, document);
   }
 
+  void SceneRoot::setChordalTolerance(std::optional<double> tolerance)
+  {
+    assert((!tolerance || *tolerance > 0) && "Tolerance must be positive.");
+    {
+      std::scoped_lock lock{toleranceMutex};
+      viewTolerance = tolerance;
+    }
+    queueTessellationChanged();
+  }
+
+  void SceneRoot::setVertexFormat(Mesh::VertexFormat format)
+  {
+    vertexFormat = format;
+    queueTessellationChanged();
+  }
+
+  void SceneRoot::setVertexCacheOptimization(bool optimize, bool weld_seams)
+  {
+    optimizeVertexCache = optimize;
+    weldSeams = weld_seams;
+    queueTessellationChanged();
+  }
+
+  void SceneRoot::setGpuBudget(size_t bytes)
+  {
+    Mesh::MeshMemoryManager::global().setGpuBudget(bytes);
+  }
+
+  Mesh::TessellationParameters SceneRoot::getTessellationParameters() const
+  {
+    Mesh::TessellationParameters result;
+    result.vertexFormat = vertexFormat;
+    result.optimizeVertexCache = optimizeVertexCache;
+    result.weldSeams = weldSeams;
+    {
+      std::scoped_lock lock{toleranceMutex};
+      if(viewTolerance) {
+        result.chordalTolerance = *viewTolerance;
+        return result;
+      }
+    }
+    auto document = documentWeak.lock();
+    if(document) {
+      result.chordalTolerance = document->getChordalTolerance();
+    }
+    return result;
+  }
+
+  void SceneRoot::slotTessellationChanged()
+  {
+    const auto parameters = getTessellationParameters();
+
+    std::vector<SharedPtr<MeshNode>> nodes;
+    {
+      Threads::ReaderGate gate{meshNodes};
+      for(const auto& [geo, node]: *gate) {
+        nodes.push_back(node);
+      }
+    }
+    // Meshes ignore parameters that did not change.
+    for(auto& node: nodes) {
+      node->setTessellationParameters(parameters);
+    }
+
+    std::scoped_lock lock{curveBatchesMutex};
+    std::erase_if(curveBatches, [](const auto& weak) { return !weak.lock(); });
+    for(const auto& batch_weak: curveBatches) {
+      if(auto batch = batch_weak.lock()) {
+        batch->setTessellationParameters(parameters);
+      }
+    }
+  }
+
+  void SceneRoot::queueTessellationChanged()
+  {
+    signalQueue->push([self_weak = self] {
+      auto self = self_weak.lock();
+      if(self) {
+        self->slotTessellationChanged();
+      }
+    }, nullptr);
+  }
+
   void SceneRoot::runQueue()
   {
     signalQueue->run_thread(signalQueue);
@@ -29,13 +29,22 @@
 #include <libparacadis/base/document_tree/DocumentTree.h>
 #include <libparacadis/base/threads/message_queue/SignalQueue.h>
 #include <libparacadis/base/threads/safe_structs/ThreadSafeMap.h>
+#include <libparacadis/mesh_provider/Tessellation.h>
 
+#include <atomic>
 #include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
 
 namespace Ogre {
   class SceneManager;
 }
 
+namespace Mesh {
+  class CurveBatch;
+}
+
 namespace SceneGraph
 {
   /**
@@ -64,8 +73,45 @@ namespace SceneGraph
     const SharedPtr<Threads::SignalQueue>& getQueue() { return signalQueue; }
     const SharedPtr<RenderingScope>& getRenderingScope() { return renderingScope; }
 
+    /**
+     * The view's chordal tolerance overrides the document's.
+     * With `std::nullopt`, the document's tolerance is used.
+     *
+     * Every mesh is tessellated again (in the signal queue).
+     */
+    void setChordalTolerance(std::optional<double> tolerance);
+    /**
+     * How the surfaces of this scene are stored in the GPU.
+     *
+     * Every mesh is tessellated again (in the signal queue).
+     */
+    void setVertexFormat(Mesh::VertexFormat format);
+    /**
+     * Reorders the triangles of the surfaces for the GPU's vertex cache,
+     * and with @a weld_seams, merges their duplicated vertices.
+     * See Mesh::optimize_vertex_cache(), and
+     * Mesh::TessellationCache::Metrics::vertexCache for the results.
+     *
+     * Every mesh is tessellated again (in the signal queue).
+     */
+    void setVertexCacheOptimization(bool optimize, bool weld_seams = false);
+    /**
+     * GPU memory for the meshes, beyond which meshes out of view are unloaded.
+     * Shared by every scene: see Mesh::MeshMemoryManager.
+     */
+    void setGpuBudget(size_t bytes);
+    Mesh::TessellationParameters getTessellationParameters() const;
+
   private:
     WeakPtr<SceneRoot>              self;
+    WeakPtr<Document::DocumentTree> documentWeak;
+
+    mutable std::mutex    toleranceMutex;
+    std::optional<double> viewTolerance;
+    std::atomic<Mesh::VertexFormat> vertexFormat = Mesh::VertexFormat::FLOAT;
+    std::atomic<bool>     optimizeVertexCache = false;
+    std::atomic<bool>     weldSeams = false;
+
     SharedPtr<Threads::SignalQueue> signalQueue;
     SharedPtr<RenderingScope>       renderingScope;
 
@@ -83,6 +129,20 @@ namespace SceneGraph
     multimap_t<geometry_t*, SharedPtr<MeshNode>> meshNodes;
     /// @}
 
+    /// The CurveBatch of each ContainerNode that has curves.
+    /// @{
+    std::mutex                             curveBatchesMutex;
+    std::vector<WeakPtr<Mesh::CurveBatch>> curveBatches;
+    /// @}
+
+    /**
+     * Passes getTessellationParameters() to every mesh and curve batch.
+     * Executed in the signal queue.
+     */
+    void slotTessellationChanged();
+    /// Pushes slotTessellationChanged() to the signal queue.
+    void queueTessellationChanged();
+
   /* OGRE stuff */
   public:
     Ogre::SceneManager* sceneManager = nullptr;
@@ -71,6 +71,9 @@ void init_document_tree(py::module_& parent_module)
       module, "Document", py::multiple_inheritance(),
       "A container to hold a full document.")
       .def(py::init<>(), "Creates an empty document.")
+      .def_property("chordal_tolerance",
+                    &DocumentTree::getChordalTolerance, &DocumentTree::setChordalTolerance,
+                    "Maximum distance between geometries and their tessellations.")
       .def("__repr__",
            [](const DocumentTree&){ return "<DOCUMENT... (put info here)>"; });
 }
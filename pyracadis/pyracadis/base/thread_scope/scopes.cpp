@@ -27,6 +27,8 @@
 
 #include <pyracadis/types.h>
 
+#include <chrono>
+
 namespace py = pybind11;
 using namespace py::literals;
 
@@ -50,15 +52,71 @@ void init_thread_scope(py::module_& module)
 }
 
 
+namespace {
+  ScopeOfScopes::duration_t from_ms(double ms)
+  {
+    return std::chrono::duration_cast<ScopeOfScopes::duration_t>(
+        std::chrono::duration<double, std::milli>(ms));
+  }
+
+  double to_ms(ScopeOfScopes::duration_t duration)
+  {
+    return std::chrono::duration<double, std::milli>(duration).count();
+  }
+}
+
 void init_scope_of_scopes(py::module_& module)
 {
+  py::enum_<ScopePriority>(
+      module, "ScopePriority",
+      "How a sub-scope is treated when the frame is over budget.")
+      .value("CRITICAL", ScopePriority::CRITICAL, "Executed every frame.")
+      .value("NORMAL", ScopePriority::NORMAL, "Deferred when it does not fit the frame budget.")
+      .value("BACKGROUND", ScopePriority::BACKGROUND, "Like NORMAL, but executed after them.");
+
   py::class_<ScopeOfScopes, DedicatedThreadScopeBase, SharedPtr<ScopeOfScopes>>(
       module, "A scope that is an array of scopes.",
       "Safely adds new scopes.")
-      .def("addScope", &ScopeOfScopes::addScope, "scope"_a,
-           "Adds a scope that will be automatically removed when it is garbage collected.")
-      .def("addScopeKeepAlive", &ScopeOfScopes::addScopeKeepAlive, "scope"_a,
+      .def("addScope",
+           [](ScopeOfScopes& self, SharedPtr<DedicatedThreadScopeBase> scope,
+              ScopePriority priority, double budget_ms, std::string name)
+           {self.addScope(scope, priority, from_ms(budget_ms), std::move(name));},
+           "scope"_a, "priority"_a = ScopePriority::CRITICAL,
+           "budget_ms"_a = 0.0, "name"_a = "",
+           "Adds a scope that will be automatically removed when it is garbage collected."
+           "\nNon-critical scopes are deferred to later frames when the frame is over budget."
+           "\nThe budget is the time the scope is expected to take (0: use the measured average).")
+      .def("addScopeKeepAlive",
+           [](ScopeOfScopes& self, SharedPtr<DedicatedThreadScopeBase> scope,
+              ScopePriority priority, double budget_ms, std::string name)
+           {self.addScopeKeepAlive(std::move(scope), priority, from_ms(budget_ms), std::move(name));},
+           "scope"_a, "priority"_a = ScopePriority::CRITICAL,
+           "budget_ms"_a = 0.0, "name"_a = "",
            "Adds a scope that will never be removed.")
+      .def("setFrameBudget",
+           [](ScopeOfScopes& self, double budget_ms){ self.setFrameBudget(from_ms(budget_ms)); },
+           "budget_ms"_a,
+           "Sets the time (in milliseconds) the sub-scopes may use in each frame.")
+      .def("getStatistics",
+           [](const ScopeOfScopes& self)
+           {
+             py::list result;
+             for(const auto& stats: self.getStatistics()) {
+               result.append(py::dict("name"_a = stats.name,
+                                      "priority"_a = stats.priority,
+                                      "budget_ms"_a = to_ms(stats.budget),
+                                      "last_ms"_a = to_ms(stats.last),
+                                      "average_ms"_a = to_ms(stats.average),
+                                      "max_ms"_a = to_ms(stats.max),
+                                      "executions"_a = stats.executions,
+                                      "deferrals"_a = stats.deferrals,
+                                      "overruns"_a = stats.overruns,
+                                      "deferred_frames"_a = stats.deferredFrames));
+             }
+             return result;
+           },
+           "Statistics of each sub-scope, as of the last frame (times in milliseconds):"
+           "\nhow often it was executed, deferred, or took longer than its budget.")
       .def("__repr__",
          [](const ScopeOfScopes&){ return "<SCOPEOFSCOPES>"; });
 }
@@ -0,0 +1,74 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "internals.h"
+
+#include <libparacadis/base/document_tree/DocumentTree.h>
+#include <libparacadis/mesh_provider/DocumentExporter.h>
+
+#include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
+
+#include <pyracadis/types.h>
+
+namespace py = pybind11;
+using namespace py::literals;
+
+using namespace Document;
+using namespace Mesh;
+
+void init_export(py::module_& module)
+{
+  py::enum_<ExportFormat>(
+      module, "ExportFormat",
+      "Mesh file formats a document can be exported to.")
+      .value("STL", ExportFormat::STL, "Binary STL (surfaces only).")
+      .value("PLY", ExportFormat::PLY, "Binary PLY with normals (surfaces only).")
+      .value("OBJ", ExportFormat::OBJ, "Wavefront OBJ, with curves as lines.");
+
+  module.def(
+      "export_document",
+      [](const std::shared_ptr<DocumentTree>& document, const std::filesystem::path& path,
+         ExportFormat format, std::optional<double> tolerance)
+      {
+        TessellationParameters parameters;
+        parameters.chordalTolerance = tolerance.value_or(document->getChordalTolerance());
+        DocumentExporter::Metrics metrics;
+        {
+          py::gil_scoped_release release;
+          metrics = DocumentExporter{format, parameters}.exportDocument(*document, path);
+        }
+        return py::dict("geometries"_a = metrics.geometries,
+                        "skipped"_a = metrics.skipped,
+                        "vertices"_a = metrics.vertices,
+                        "triangles"_a = metrics.triangles,
+                        "segments"_a = metrics.segments,
+                        "bytes"_a = metrics.bytes,
+                        "seconds"_a = metrics.elapsed.count(),
+                        "megabytes_per_second"_a = metrics.megabytesPerSecond(),
+                        "triangles_per_second"_a = metrics.trianglesPerSecond());
+      },
+      "document"_a, "path"_a, "format"_a = ExportFormat::STL, "tolerance"_a = py::none(),
+      "Writes the tessellation of every geometry in 'document' to the file 'path'."
+      "\nThe tolerance defaults to the document's chordal tolerance."
+      "\nReturns what was written and how fast.");
+}
@@ -29,3 +29,5 @@ namespace py = pybind11;
 void init_rendering_scope(py::module_& module);
 void init_scene(py::module_& module);
 void init_imgui(py::module_& module);
+void init_export(py::module_& module);
+void init_tessellation_cache(py::module_& module);
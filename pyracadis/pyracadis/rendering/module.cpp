@@ -35,4 +35,6 @@ void init_rendering(py::module_& parent_module)
   init_rendering_scope(m);
   init_scene(m);
   init_imgui(m);
+  init_export(m);
+  init_tessellation_cache(m);
 }
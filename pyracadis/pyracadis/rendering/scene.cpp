@@ -34,6 +34,7 @@
 #include <OGRE/Bites/OgreInput.h>
 
 #include <Python.h>
+#include <pybind11/stl.h>  // std::optional for the chordal tolerance.
 
 #include <pyracadis/types.h>
 
@@ -76,6 +77,12 @@ namespace {
 
 void init_scene(py::module_& module)
 {
+  py::enum_<Mesh::VertexFormat>(
+      module, "VertexFormat",
+      "How the surfaces of a scene are stored in the GPU.")
+      .value("FLOAT", Mesh::VertexFormat::FLOAT, "Float positions and normals (24 bytes per vertex).")
+      .value("COMPACT", Mesh::VertexFormat::COMPACT, "16-bit positions, scaled by the scene node, and byte normals (12 bytes per vertex).");
+
   py::class_<SceneRoot, SharedPtr<SceneRoot>>(
       module, "Scene",
       "A scene graph with a message queue that keeps it updated.")
@@ -86,6 +93,23 @@ void init_scene(py::module_& module)
            {self->populate(std::move(self), std::move(doc));},
            "document"_a,
            "Populates the scene with the contents of 'document'.")
+      .def("set_chordal_tolerance", &SceneRoot::setChordalTolerance,
+           "tolerance"_a = py::none(),
+           "Overrides the document's chordal tolerance for this scene (None to use the document's).")
+      .def("set_vertex_format", &SceneRoot::setVertexFormat,
+           "format"_a,
+           "Sets how the surfaces of this scene are stored in the GPU.")
+      .def("set_vertex_cache_optimization", &SceneRoot::setVertexCacheOptimization,
+           "optimize"_a, "weld_seams"_a = false,
+           "Reorders the triangles of the surfaces for the GPU's vertex cache,"
+           "\nand with 'weld_seams', merges their duplicated vertices."
+           "\nSee 'vertex_cache' in tessellation_cache_metrics().")
+      .def("set_gpu_budget",
+           [](SceneRoot& self, double megabytes)
+           {self.setGpuBudget(size_t(megabytes * 1024 * 1024));},
+           "megabytes"_a,
+           "Unloads meshes out of view when the meshes take more GPU memory than this."
+           "\nShared by every scene.")
       .def("__repr__",
            [](const SceneRoot&){ return "<SCENE... (put info here)>"; });
 }
@@ -0,0 +1,94 @@
+// SPDX-License-Identifier: GPL-3.0-or-later
+/****************************************************************************
+ *                                                                          *
+ *   Copyright (c) 2024 André Caldas <andre.em.caldas@gmail.com>            *
+ *                                                                          *
+ *   This file is part of ParaCADis.                                        *
+ *                                                                          *
+ *   ParaCADis is free software: you can redistribute it and/or modify it   *
+ *   under the terms of the GNU General Public License as published         *
+ *   by the Free Software Foundation, either version 2.1 of the License,    *
+ *   or (at your option) any later version.                                 *
+ *                                                                          *
+ *   ParaCADis is distributed in the hope that it will be useful, but       *
+ *   WITHOUT ANY WARRANTY; without even the implied warranty of             *
+ *   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.                   *
+ *   See the GNU General Public License for more details.                   *
+ *                                                                          *
+ *   You should have received a copy of the GNU General Public License      *
+ *   along with ParaCADis. If not, see <https://www.gnu.org/licenses/>.     *
+ *                                                                          *
+ ***************************************************************************/
+
+#include "internals.h"
+
+#include <libparacadis/mesh_provider/TessellationCache.h>
+#include <libparacadis/mesh_provider/TessellationDiskCache.h>
+
+#include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
+
+#include <pyracadis/types.h>
+
+#include <memory>
+#include <optional>
+
+namespace py = pybind11;
+using namespace py::literals;
+
+using namespace Mesh;
+
+void init_tessellation_cache(py::module_& module)
+{
+  module.def(
+      "set_tessellation_cache_directory",
+      [](const std::optional<std::filesystem::path>& directory, double capacity_megabytes)
+      {
+        std::shared_ptr<TessellationDiskCache> disk_cache;
+        if(directory) {
+          disk_cache = std::make_shared<TessellationDiskCache>(
+              *directory, size_t(capacity_megabytes * 1024 * 1024));
+        }
+        TessellationCache::global().setDiskCache(std::move(disk_cache));
+      },
+      "directory"_a, "capacity_megabytes"_a = 1024.,
+      "Keeps tessellations in files in 'directory', so documents reopen faster."
+      "\nThe least recently used files are removed beyond 'capacity_megabytes'."
+      "\nNone disables it.");
+
+  module.def(
+      "tessellation_cache_metrics",
+      []()
+      {
+        const auto memory = TessellationCache::global().getMetrics();
+        py::dict result("hits"_a = memory.hits,
+                        "misses"_a = memory.misses,
+                        "evictions"_a = memory.evictions,
+                        "entries"_a = memory.entries,
+                        "bytes"_a = memory.bytes,
+                        "capacity"_a = memory.capacity);
+        const auto& stats = memory.vertexCache;
+        result["vertex_cache"] = py::dict("triangles_before"_a = stats.trianglesBefore,
+                                          "triangles_after"_a = stats.trianglesAfter,
+                                          "misses_before"_a = stats.missesBefore,
+                                          "misses_after"_a = stats.missesAfter,
+                                          "welded"_a = stats.welded,
+                                          "acmr_before"_a = stats.acmrBefore(),
+                                          "acmr_after"_a = stats.acmrAfter());
+        if(const auto disk_cache = TessellationCache::global().getDiskCache()) {
+          const auto disk = disk_cache->getMetrics();
+          result["disk"] = py::dict("directory"_a = disk_cache->getDirectory(),
+                                    "hits"_a = disk.hits,
+                                    "misses"_a = disk.misses,
+                                    "stores"_a = disk.stores,
+                                    "evictions"_a = disk.evictions,
+                                    "invalidated"_a = disk.invalidated,
+                                    "queued"_a = disk.queued,
+                                    "files"_a = disk.files,
+                                    "bytes"_a = disk.bytes,
+                                    "capacity"_a = disk.capacity);
+        }
+        return result;
+      },
+      "How the tessellation cache (in memory, and on disk, if any) is doing.");
+}